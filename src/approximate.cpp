@@ -0,0 +1,504 @@
+#include "hull.hpp"
+#include "dop.hpp"
+#include "predicates.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// Forward Declarations
+template <typename Scalar>
+std::vector<size_t> extreme_points(
+    const Hull::BasicPointSpan<Scalar>& points, const size_t& directions,
+    Scalar& extent);
+template <typename Scalar>
+bool is_flat(
+    const std::vector<Hull::Point<Scalar>>& vertices, const Scalar& margin,
+    Hull::Point<Scalar>& normal) noexcept;
+template <typename Scalar>
+size_t farthest_off_plane(
+    const Hull::BasicPointSpan<Scalar>& points,
+    const Hull::Point<Scalar>& origin, const Hull::Point<Scalar>& normal,
+    const Scalar& margin) noexcept;
+template <typename Scalar>
+size_t farthest_off_line(
+    const Hull::BasicPointSpan<Scalar>& points,
+    const Hull::Point<Scalar>& origin, const Hull::Point<Scalar>& direction,
+    const Scalar& margin) noexcept;
+template <typename Scalar>
+std::array<size_t, 3>
+spanning_points(const std::vector<Hull::Point<Scalar>>& vertices) noexcept;
+template <typename Scalar>
+Scalar triangle_distance(
+    const Hull::Point<Scalar>& point, const Hull::Point<Scalar>& a,
+    const Hull::Point<Scalar>& b, const Hull::Point<Scalar>& c) noexcept;
+
+template <typename Scalar>
+std::vector<Hull::Point<Scalar>> Hull::approximate_convex_hull(
+    const std::vector<Point<Scalar>>& points,
+    const ApproximateOptions& options, Scalar* error) {
+    return approximate_convex_hull(
+        BasicPointSpan<Scalar>{ points.data(), points.size() }, options,
+        error);
+}
+
+template <typename Scalar>
+std::vector<Hull::Point<Scalar>> Hull::approximate_convex_hull(
+    const BasicPointSpan<Scalar>& points, const ApproximateOptions& options,
+    Scalar* error) {
+    // Return early if not at-least a tetrahedron
+    if (error != nullptr)
+        *error = Scalar(0);
+    if (points.count < 4ULL)
+        return {};
+
+    // A triangulated hull of 'v' vertices has at most 2v - 4 faces
+    const auto vertexBudget =
+        options.maxFaces == 0ULL
+            ? points.count
+            : std::max<size_t>(options.maxFaces / 2ULL + 2ULL, 4ULL);
+
+    // Start from the extreme points along a fixed set of directions. Points
+    // closer than the rounding of the planes never count as outside.
+    auto extent(Scalar(0));
+    auto chosen = extreme_points(
+        points, std::min<size_t>(vertexBudget, 26ULL), extent);
+    std::vector<unsigned char> isChosen(points.count, 0);
+    for (const auto& id : chosen)
+        isChosen[id] = 1;
+    const auto margin = Hull::Predicates::plane_margin(extent);
+    const auto tolerance =
+        std::max(static_cast<Scalar>(options.epsilon), margin);
+
+    // Refine the hull of the chosen points until every point lies close
+    // enough to it, or the budget is spent. Each round adds the point lying
+    // farthest outside each face, and drops the points found inside, as the
+    // hull only ever grows.
+    std::vector<size_t> survivors(points.count);
+    std::iota(survivors.begin(), survivors.end(), 0ULL);
+    std::vector<Point<Scalar>> vertices;
+    std::vector<std::array<size_t, 3>> facets;
+    std::vector<Scalar> faceError;
+    std::vector<size_t> faceWorst;
+    std::vector<size_t> worstFaces;
+    Simd::BasicPlanes<Scalar> planes;
+    BasicMesh<int> mesh;
+    auto bound(Scalar(0));
+    size_t widenings(0ULL);
+    auto lifted(false);
+    auto flat(false);
+    auto flatOrigin = Point<Scalar>(Scalar(0));
+    auto flatNormal = Point<Scalar>(Scalar(0));
+    for (;;) {
+        vertices.resize(chosen.size());
+        std::transform(
+            chosen.cbegin(), chosen.cend(), vertices.begin(),
+            [&points](const size_t& id) { return points[id]; });
+        mesh = generate_convex_mesh(vertices);
+
+        // Points on a line have no hull, so widen the line with the point
+        // farthest from it, keeping only its ends, and any other points to
+        // make up the 4 a hull needs. Points that all lie on the line, as
+        // far as rounding can tell, have no hull at all.
+        if (mesh.indices.empty()) {
+            const auto span = spanning_points(vertices);
+            const auto& origin = vertices[span[0]];
+            auto direction = vertices[span[1]] - origin;
+            if (direction.dot(direction) > Scalar(0))
+                direction = Point<Scalar>::normalize(direction);
+            const auto farthest =
+                farthest_off_line(points, origin, direction, margin);
+            if (farthest == points.count || ++widenings > 2ULL)
+                return {};
+            std::vector<size_t> widened{ chosen[span[0]] };
+            if (span[1] != span[0])
+                widened.emplace_back(chosen[span[1]]);
+            widened.emplace_back(farthest);
+            for (size_t id = 0ULL; widened.size() < 4ULL; ++id)
+                if (std::find(widened.cbegin(), widened.cend(), id) ==
+                    widened.cend())
+                    widened.emplace_back(id);
+            for (const auto& id : chosen)
+                isChosen[id] = 0;
+            chosen.swap(widened);
+            for (const auto& id : chosen)
+                isChosen[id] = 1;
+            continue;
+        }
+
+        // A flat hull's planes cannot tell the points beyond its edges
+        // apart, so lift it off its plane once by choosing the point
+        // farthest from it. If the budget is spent, it replaces a point not
+        // needed to span the plane. When every point lies on the plane, or
+        // the hull stays flat, it gets refined by its edges instead.
+        if (!flat) {
+            flatNormal = Point<Scalar>(Scalar(0));
+            if (is_flat(vertices, margin, flatNormal)) {
+                const auto farthest = farthest_off_plane(
+                    points, vertices[0], flatNormal, margin);
+                if (lifted || farthest == points.count) {
+                    flat = true;
+                    flatOrigin = vertices[0];
+                } else {
+                    lifted = true;
+                    if (chosen.size() >= vertexBudget) {
+                        const auto span = spanning_points(vertices);
+                        auto drop = chosen.size() - 1ULL;
+                        while (drop == span[0] || drop == span[1] ||
+                               drop == span[2])
+                            --drop;
+                        isChosen[chosen[drop]] = 0;
+                        chosen.erase(chosen.begin() + drop);
+                    }
+                    isChosen[farthest] = 1;
+                    chosen.emplace_back(farthest);
+                    continue;
+                }
+            }
+        }
+
+        // Gather the plane of every face, or of a flat hull every edge
+        // around it, standing upright on its plane. Each edge counts as a
+        // face whose last 2 corners are the same.
+        const auto corner = [&](const size_t& index) -> const Point<Scalar>& {
+            return vertices[mesh.vertices[mesh.indices[index]]];
+        };
+        const auto face_normal = [&corner](const size_t& face) {
+            const auto& v0 = corner(face * 3ULL);
+            return Point<Scalar>::normalize(
+                (corner(face * 3ULL + 1ULL) - v0)
+                    .cross(corner(face * 3ULL + 2ULL) - v0));
+        };
+        planes.clear();
+        facets.clear();
+        for (size_t face = 0ULL; face < mesh.indices.size() / 3ULL; ++face) {
+            const auto normal = face_normal(face);
+            if (!flat) {
+                planes.push_back(
+                    normal.x(), normal.y(), normal.z(),
+                    normal.dot(corner(face * 3ULL)));
+                facets.push_back({ face * 3ULL, face * 3ULL + 1ULL,
+                                   face * 3ULL + 2ULL });
+                continue;
+            }
+            if (!(normal.dot(flatNormal) > Scalar(0)))
+                continue;
+            for (size_t edge = 0ULL; edge < 3ULL; ++edge) {
+                const auto across =
+                    static_cast<size_t>(mesh.adjacency[face * 3ULL + edge]);
+                if (face_normal(across).dot(flatNormal) > Scalar(0))
+                    continue;
+                const auto from = face * 3ULL + edge;
+                const auto to = face * 3ULL + (edge + 1ULL) % 3ULL;
+                const auto outward = Point<Scalar>::normalize(
+                    (corner(to) - corner(from)).cross(flatNormal));
+                planes.push_back(
+                    outward.x(), outward.y(), outward.z(),
+                    outward.dot(corner(from)));
+                facets.push_back({ from, to, to });
+            }
+        }
+
+        // Bound how far each point lies from the hull by its distance to
+        // the face it lies farthest above, a face being part of the hull.
+        // Points over a flat hull lie as far from it as from its plane.
+        const auto faceCount = facets.size();
+        faceError.assign(faceCount, Scalar(0));
+        faceWorst.assign(faceCount, 0ULL);
+        bound = Scalar(0);
+        size_t kept(0ULL);
+        for (const auto& id : survivors) {
+            const auto point = points[id];
+            auto above(Scalar(0));
+            const auto face = Simd::farthest_above(
+                planes, point.x(), point.y(), point.z(), above);
+            if (face < 0) {
+                if (flat)
+                    bound = std::max(
+                        bound, std::abs(flatNormal.dot(point - flatOrigin)));
+                continue;
+            }
+            survivors[kept++] = id;
+            const auto& facet = facets[static_cast<size_t>(face)];
+            const auto distance = triangle_distance(
+                point, corner(facet[0]), corner(facet[1]), corner(facet[2]));
+            bound = std::max(bound, distance);
+            if (distance > faceError[face] && isChosen[id] == 0) {
+                faceError[face] = distance;
+                faceWorst[face] = id;
+            }
+        }
+        survivors.resize(kept);
+        if (bound <= tolerance || chosen.size() >= vertexBudget)
+            break;
+
+        // Add the worst point of each face, worst faces first
+        worstFaces.clear();
+        for (size_t face = 0ULL; face < faceCount; ++face)
+            if (faceError[face] > tolerance)
+                worstFaces.emplace_back(face);
+        std::sort(
+            worstFaces.begin(), worstFaces.end(),
+            [&faceError](const size_t& a, const size_t& b) {
+                return faceError[a] > faceError[b];
+            });
+        const auto before = chosen.size();
+        for (const auto& face : worstFaces) {
+            if (chosen.size() >= vertexBudget)
+                break;
+            const auto id = faceWorst[face];
+            if (isChosen[id] == 0) {
+                isChosen[id] = 1;
+                chosen.emplace_back(id);
+            }
+        }
+        if (chosen.size() == before)
+            break;
+    }
+
+    // Grow a conservative hull about the center of its points, until each
+    // plane has moved out by the error bound and the rounding of it, so
+    // every point lies inside. The bound becomes how far the hull reaches
+    // past the farthest point, which its vertices move no farther than.
+    if (options.conservative) {
+        auto center = Point<Scalar>(Scalar(0));
+        for (const auto& vertex : vertices)
+            center = center + vertex;
+        center = center / Point<Scalar>(Scalar(vertices.size()));
+        auto nearest = std::numeric_limits<Scalar>::max();
+        for (size_t plane = 0ULL; plane < planes.count; ++plane)
+            nearest = std::min(
+                nearest, planes.offset[plane] -
+                             (planes.x[plane] * center.x() +
+                              planes.y[plane] * center.y() +
+                              planes.z[plane] * center.z()));
+        const auto growth = (bound + margin) / std::max(nearest, margin);
+        auto reach(Scalar(0));
+        for (auto& vertex : vertices) {
+            const auto offset = vertex - center;
+            reach = std::max(reach, std::sqrt(offset.dot(offset)));
+            vertex = center + offset * Point<Scalar>(Scalar(1) + growth);
+        }
+        bound = reach * growth;
+    }
+
+    // A flat hull's faces may fan out from points inside of it, so cover
+    // both of its sides with a fan around its edges instead
+    const auto vertex = [&](const size_t& index) -> const Point<Scalar>& {
+        return vertices[mesh.vertices[index]];
+    };
+    std::vector<Point<Scalar>> triangles;
+    if (flat) {
+        std::vector<size_t> next(mesh.vertices.size(), 0ULL);
+        for (const auto& facet : facets)
+            next[mesh.indices[facet[0]]] = mesh.indices[facet[1]];
+        const auto first = static_cast<size_t>(mesh.indices[facets[0][0]]);
+        auto from = next[first];
+        for (size_t edge = 2ULL; edge < facets.size(); ++edge) {
+            triangles.insert(
+                triangles.end(), { vertex(first), vertex(from),
+                                   vertex(next[from]), vertex(first),
+                                   vertex(next[from]), vertex(from) });
+            from = next[from];
+        }
+    } else {
+        triangles.reserve(mesh.indices.size());
+        for (const auto& index : mesh.indices)
+            triangles.emplace_back(vertex(index));
+    }
+    if (error != nullptr)
+        *error = bound;
+    return triangles;
+}
+
+// Find the distinct points reaching farthest along the first 'directions'
+// directions of a 26-DOP, and the largest magnitude of any coordinate.
+template <typename Scalar>
+std::vector<size_t> extreme_points(
+    const Hull::BasicPointSpan<Scalar>& points, const size_t& directions,
+    Scalar& extent) {
+    std::vector<size_t> extremes(directions, 0ULL);
+    std::vector<Scalar> farthest(
+        directions, std::numeric_limits<Scalar>::lowest());
+    extent = Scalar(0);
+    for (size_t i = 0ULL; i < points.count; ++i) {
+        const auto point = points[i];
+        for (size_t axis = 0ULL; axis < 3ULL; ++axis)
+            extent = std::max(extent, std::abs(point.data()[axis]));
+        for (size_t direction = 0ULL; direction < directions; ++direction) {
+            const auto* axes = Hull::dopDirections[direction];
+            const auto distance = point.x() * static_cast<Scalar>(axes[0]) +
+                                  point.y() * static_cast<Scalar>(axes[1]) +
+                                  point.z() * static_cast<Scalar>(axes[2]);
+            if (distance > farthest[direction]) {
+                farthest[direction] = distance;
+                extremes[direction] = i;
+            }
+        }
+    }
+
+    // Keep the first direction reaching each point
+    std::vector<size_t> distinct;
+    for (const auto& id : extremes)
+        if (std::find(distinct.cbegin(), distinct.cend(), id) ==
+            distinct.cend())
+            distinct.emplace_back(id);
+    return distinct;
+}
+
+// Check if some points all lie on one plane, finding its unit normal from
+// the largest triangle of consecutive points.
+template <typename Scalar>
+bool is_flat(
+    const std::vector<Hull::Point<Scalar>>& vertices, const Scalar& margin,
+    Hull::Point<Scalar>& normal) noexcept {
+    const auto& origin = vertices[0];
+    for (size_t i = 1ULL; i + 1ULL < vertices.size(); ++i) {
+        const auto cross =
+            (vertices[i] - origin).cross(vertices[i + 1ULL] - origin);
+        if (cross.dot(cross) > normal.dot(normal))
+            normal = cross;
+    }
+    if (normal.dot(normal) <= Scalar(0))
+        return true;
+    normal = Hull::Point<Scalar>::normalize(normal);
+    for (const auto& vertex : vertices)
+        if (std::abs(normal.dot(vertex - origin)) > margin)
+            return false;
+    return true;
+}
+
+// Find the point farthest from a plane, or the point count if every point
+// lies within 'margin' of it.
+template <typename Scalar>
+size_t farthest_off_plane(
+    const Hull::BasicPointSpan<Scalar>& points,
+    const Hull::Point<Scalar>& origin, const Hull::Point<Scalar>& normal,
+    const Scalar& margin) noexcept {
+    auto best(margin);
+    auto farthest(points.count);
+    for (size_t i = 0ULL; i < points.count; ++i) {
+        const auto distance = std::abs(normal.dot(points[i] - origin));
+        if (distance > best) {
+            best = distance;
+            farthest = i;
+        }
+    }
+    return farthest;
+}
+
+// Find the point farthest from a line through an origin along a unit
+// direction, or from the origin alone if the direction is zero. Returns the
+// point count if every point lies within 'margin' of it.
+template <typename Scalar>
+size_t farthest_off_line(
+    const Hull::BasicPointSpan<Scalar>& points,
+    const Hull::Point<Scalar>& origin, const Hull::Point<Scalar>& direction,
+    const Scalar& margin) noexcept {
+    auto best(margin * margin);
+    auto farthest(points.count);
+    for (size_t i = 0ULL; i < points.count; ++i) {
+        const auto delta = points[i] - origin;
+        const auto cross = direction.cross(delta);
+        const auto distance = direction.dot(direction) > Scalar(0)
+                                  ? cross.dot(cross)
+                                  : delta.dot(delta);
+        if (distance > best) {
+            best = distance;
+            farthest = i;
+        }
+    }
+    return farthest;
+}
+
+// Find 3 of some points spreading as far apart as they can: the point
+// farthest from the first, the point farthest from that one, and the point
+// farthest from the line through those two. On a line, the first 2 are its
+// ends.
+template <typename Scalar>
+std::array<size_t, 3>
+spanning_points(const std::vector<Hull::Point<Scalar>>& vertices) noexcept {
+    const auto farthest_from = [&vertices](const auto& distance) {
+        size_t best(0ULL);
+        for (size_t i = 1ULL; i < vertices.size(); ++i)
+            if (distance(vertices[i]) > distance(vertices[best]))
+                best = i;
+        return best;
+    };
+    const auto length_to = [](const Hull::Point<Scalar>& from) {
+        return [&from](const Hull::Point<Scalar>& to) {
+            const auto delta = to - from;
+            return delta.dot(delta);
+        };
+    };
+    const auto first = farthest_from(length_to(vertices[0]));
+    const auto second = farthest_from(length_to(vertices[first]));
+    const auto& origin = vertices[first];
+    const auto line = vertices[second] - origin;
+    const auto third = farthest_from([&](const Hull::Point<Scalar>& point) {
+        const auto cross = line.cross(point - origin);
+        return cross.dot(cross);
+    });
+    return { first, second, third };
+}
+
+// Find the distance from a point to the closest point of a triangle, by
+// finding which of its regions the point projects into (Ericson). When the
+// last 2 corners are the same, it is the distance to the edge they make.
+template <typename Scalar>
+Scalar triangle_distance(
+    const Hull::Point<Scalar>& point, const Hull::Point<Scalar>& a,
+    const Hull::Point<Scalar>& b, const Hull::Point<Scalar>& c) noexcept {
+    const auto distance_to = [&point](const Hull::Point<Scalar>& closest) {
+        const auto delta = point - closest;
+        return std::sqrt(delta.dot(delta));
+    };
+    const auto ab = b - a;
+    const auto ac = c - a;
+    const auto ap = point - a;
+    const auto d1 = ab.dot(ap);
+    const auto d2 = ac.dot(ap);
+    if (d1 <= Scalar(0) && d2 <= Scalar(0))
+        return distance_to(a);
+    const auto bp = point - b;
+    const auto d3 = ab.dot(bp);
+    const auto d4 = ac.dot(bp);
+    if (d3 >= Scalar(0) && d4 <= d3)
+        return distance_to(b);
+    const auto vc = d1 * d4 - d3 * d2;
+    if (vc <= Scalar(0) && d1 >= Scalar(0) && d3 <= Scalar(0))
+        return distance_to(a + ab * Hull::Point<Scalar>(d1 / (d1 - d3)));
+    const auto cp = point - c;
+    const auto d5 = ab.dot(cp);
+    const auto d6 = ac.dot(cp);
+    if (d6 >= Scalar(0) && d5 <= d6)
+        return distance_to(c);
+    const auto vb = d5 * d2 - d1 * d6;
+    if (vb <= Scalar(0) && d2 >= Scalar(0) && d6 <= Scalar(0))
+        return distance_to(a + ac * Hull::Point<Scalar>(d2 / (d2 - d6)));
+    const auto va = d3 * d6 - d5 * d4;
+    if (va <= Scalar(0) && d4 - d3 >= Scalar(0) && d5 - d6 >= Scalar(0))
+        return distance_to(
+            b + (c - b) *
+                    Hull::Point<Scalar>((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+    const auto denominator = Scalar(1) / (va + vb + vc);
+    return distance_to(
+        a + ab * Hull::Point<Scalar>(vb * denominator) +
+        ac * Hull::Point<Scalar>(vc * denominator));
+}
+
+// Explicit Instantiations
+template std::vector<Hull::Point<float>> Hull::approximate_convex_hull(
+    const std::vector<Point<float>>& points,
+    const ApproximateOptions& options, float* error);
+template std::vector<Hull::Point<double>> Hull::approximate_convex_hull(
+    const std::vector<Point<double>>& points,
+    const ApproximateOptions& options, double* error);
+template std::vector<Hull::Point<float>> Hull::approximate_convex_hull(
+    const BasicPointSpan<float>& points, const ApproximateOptions& options,
+    float* error);
+template std::vector<Hull::Point<double>> Hull::approximate_convex_hull(
+    const BasicPointSpan<double>& points, const ApproximateOptions& options,
+    double* error);
@@ -0,0 +1,257 @@
+#include "hull.hpp"
+#include "pointIO.hpp"
+#include "stream.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Settings parsed from the command line. */
+struct Arguments {
+    // Attributes
+    std::string input;         // the file to read points from.
+    std::string output;        // the file to write the hull to.
+    Hull::Options options;     // the settings to generate the hull with.
+    size_t chunkPoints = 0ULL; // points per streamed chunk, 0 to not stream.
+    bool stats = false;        // print timings and measurements.
+};
+
+/** Timings of each phase of a run, in seconds. */
+struct Timings {
+    // Attributes
+    double read = 0.0;  // reading the points into memory.
+    double hull = 0.0;  // generating the hull.
+    double write = 0.0; // writing the hull out.
+};
+
+/** Print how the tool is used. */
+void print_usage() {
+    std::cerr
+        << "usage: convexHullCli <input> <output> [options]\n"
+        << "  input:  .bin/.raw/.f32 (float32 x y z), .xyz/.txt/.pts, .ply\n"
+        << "  output: .ply (binary) or .obj\n"
+        << "  --algorithm incremental|quickhull  the engine to use\n"
+        << "  --threads N                        slab-parallel threads\n"
+        << "  --prefilter                        cull interior points first\n"
+        << "  --order sorted|morton|biased       point insertion order\n"
+        << "  --chunk N                          stream N points at a time\n"
+        << "  --stats                            print per-phase timings\n";
+}
+
+/** Parse the command line into a set of arguments.
+@param  argc        the number of arguments.
+@param  argv        the arguments.
+@param  arguments   output settings.
+@return true if the command line was valid, false otherwise. */
+bool parse_arguments(const int& argc, char* argv[], Arguments& arguments) {
+    std::vector<std::string> positional;
+    for (auto i = 1; i < argc; ++i) {
+        const std::string argument(argv[i]);
+        const auto hasValue = i + 1 < argc;
+        if (argument == "--prefilter")
+            arguments.options.prefilter = true;
+        else if (argument == "--stats")
+            arguments.stats = true;
+        else if (argument == "--algorithm" && hasValue) {
+            const std::string value(argv[++i]);
+            if (value == "incremental")
+                arguments.options.algorithm = Hull::Algorithm::Incremental;
+            else if (value == "quickhull")
+                arguments.options.algorithm = Hull::Algorithm::QuickHull;
+            else
+                return false;
+        } else if (argument == "--order" && hasValue) {
+            const std::string value(argv[++i]);
+            if (value == "sorted")
+                arguments.options.order = Hull::InsertionOrder::Sorted;
+            else if (value == "morton")
+                arguments.options.order = Hull::InsertionOrder::Morton;
+            else if (value == "biased")
+                arguments.options.order = Hull::InsertionOrder::Biased;
+            else
+                return false;
+        } else if (argument == "--threads" && hasValue)
+            arguments.options.threads = std::strtoull(argv[++i], nullptr, 10);
+        else if (argument == "--chunk" && hasValue)
+            arguments.chunkPoints = std::strtoull(argv[++i], nullptr, 10);
+        else if (argument.rfind("--", 0ULL) == 0ULL)
+            return false;
+        else
+            positional.emplace_back(argument);
+    }
+    if (positional.size() != 2ULL)
+        return false;
+    arguments.input = positional[0];
+    arguments.output = positional[1];
+    return true;
+}
+
+/** Find the seconds elapsed since a point in time.
+@param  start   the point in time to measure from.
+@return the seconds elapsed since 'start'. */
+double seconds_since(const std::chrono::steady_clock::time_point& start) {
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/** Stream the hull of a binary file a chunk at a time, then write it out.
+Only raw files and PLY files with packed float vertices can be streamed.
+@param  arguments   the settings to run with.
+@param  timings     output timings of each phase.
+@param  stats       output measurements taken while hulling.
+@param  pointCount  output number of points read.
+@return the number of hull faces written, or -1 on failure. */
+long long stream_hull(
+    const Arguments& arguments, Timings& timings, Hull::Stats& stats,
+    size_t& pointCount) {
+    Hull::StreamOptions streamOptions;
+    streamOptions.chunkPoints = arguments.chunkPoints;
+    streamOptions.hull = arguments.options;
+    Hull::StreamProgress progress;
+    streamOptions.progress = [&](const Hull::StreamProgress& report) {
+        progress = report;
+    };
+    const auto format = Hull::IO::format_of(arguments.input);
+    if (format == Hull::IO::Format::PLY) {
+        Hull::IO::PlyLayout layout;
+        if (!Hull::IO::read_ply_layout(arguments.input, layout) ||
+            !layout.packed)
+            return -1;
+        streamOptions.offset = layout.offset + layout.coordinate[0];
+        streamOptions.stride = layout.stride;
+        streamOptions.count = layout.count;
+    } else if (format != Hull::IO::Format::Raw)
+        return -1;
+
+    // The streamed hull comes back as triangles, so index it once more
+    auto start = std::chrono::steady_clock::now();
+    const auto soup =
+        Hull::stream_convex_hull(arguments.input, streamOptions, &stats);
+    if (soup.empty())
+        return -1;
+    const auto mesh(Hull::generate_convex_mesh(soup, arguments.options));
+    timings.hull = seconds_since(start);
+    pointCount = progress.totalPoints;
+
+    start = std::chrono::steady_clock::now();
+    if (!Hull::IO::write_mesh(arguments.output, soup, mesh))
+        return -1;
+    timings.write = seconds_since(start);
+    return static_cast<long long>(mesh.indices.size() / 3ULL);
+}
+
+/** Hull points held in memory, then write the hull out.
+@tparam Index       the index type to build the hull with.
+@param  points      the points to hull.
+@param  arguments   the settings to run with.
+@param  timings     output timings of each phase.
+@param  stats       output measurements taken while hulling.
+@return the number of hull faces written, or -1 on failure. */
+template <typename Index>
+long long hull_in_memory(
+    const std::vector<vec3>& points, const Arguments& arguments,
+    Timings& timings, Hull::Stats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    const auto mesh(
+        Hull::generate_convex_mesh<Index>(points, arguments.options, &stats));
+    timings.hull = seconds_since(start);
+    if (mesh.indices.empty())
+        return -1;
+
+    start = std::chrono::steady_clock::now();
+    if (!Hull::IO::write_mesh(arguments.output, points, mesh))
+        return -1;
+    timings.write = seconds_since(start);
+    return static_cast<long long>(mesh.indices.size() / 3ULL);
+}
+
+/** Print the timings and measurements of a run.
+@param  pointCount  the number of points read.
+@param  faces       the number of hull faces written.
+@param  timings     the timings of each phase of the run.
+@param  stats       the measurements taken while hulling. */
+void print_stats(
+    const size_t& pointCount, const long long& faces, const Timings& timings,
+    const Hull::Stats& stats) {
+    const auto milliseconds = [](const std::uint64_t& nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1e6;
+    };
+    std::cout << "points:           " << pointCount << '\n'
+              << "faces:            " << faces << '\n'
+              << "read:             " << timings.read * 1e3 << " ms\n"
+              << "hull:             " << timings.hull * 1e3 << " ms\n"
+              << "  prefilter:      " << milliseconds(stats.prefilterNs)
+              << " ms\n"
+              << "  sort:           " << milliseconds(stats.sortNs) << " ms\n"
+              << "  flat:           " << milliseconds(stats.flatNs) << " ms\n"
+              << "  file:           " << milliseconds(stats.fileNs) << " ms\n"
+              << "  insert:         " << milliseconds(stats.insertNs)
+              << " ms\n"
+              << "  renumber:       " << milliseconds(stats.renumberNs)
+              << " ms\n"
+              << "  output:         " << milliseconds(stats.outputNs)
+              << " ms\n"
+              << "write:            " << timings.write * 1e3 << " ms\n"
+              << "culled points:    " << stats.culledPoints << '\n'
+              << "points inserted:  " << stats.pointsInserted << '\n'
+              << "points interior:  " << stats.pointsInterior << '\n'
+              << "coplanar points:  " << stats.coplanarPoints << '\n'
+              << "visibility tests: " << stats.visibilityTests << '\n'
+              << "facets created:   " << stats.facetsCreated << '\n'
+              << "facets retired:   " << stats.facetsRetired << '\n'
+              << "horizon edges:    " << stats.horizonEdges << '\n'
+              << "max horizon:      " << stats.maxHorizon << '\n'
+              << "peak facets:      " << stats.peakFacets << '\n'
+              << "peak bytes:       " << stats.peakBytes << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    Arguments arguments;
+    if (!parse_arguments(argc, argv, arguments)) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    if (Hull::IO::format_of(arguments.output) != Hull::IO::Format::PLY &&
+        Hull::IO::format_of(arguments.output) != Hull::IO::Format::OBJ) {
+        std::cerr << "Unsupported output format: " << arguments.output << '\n';
+        return EXIT_FAILURE;
+    }
+
+    Timings timings;
+    Hull::Stats stats;
+    size_t pointCount(0ULL);
+    long long faces(-1);
+    if (arguments.chunkPoints > 0ULL)
+        faces = stream_hull(arguments, timings, stats, pointCount);
+    else {
+        // Parse text across every hardware thread
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<vec3> points;
+        Hull::ThreadPool pool(std::thread::hardware_concurrency());
+        if (!Hull::IO::read_points(
+                arguments.input, points, Hull::IO::Format::Auto, &pool)) {
+            std::cerr << "Could not read points from: " << arguments.input
+                      << '\n';
+            return EXIT_FAILURE;
+        }
+        timings.read = seconds_since(start);
+        pointCount = points.size();
+        faces = points.size() > Hull::maxPoints<int>
+                    ? hull_in_memory<std::int64_t>(
+                          points, arguments, timings, stats)
+                    : hull_in_memory<int>(points, arguments, timings, stats);
+    }
+    if (faces < 0) {
+        std::cerr << "Could not hull " << arguments.input << " into "
+                  << arguments.output << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if (arguments.stats)
+        print_stats(pointCount, faces, timings, stats);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,26 @@
+#ifndef DOP_HPP
+#define DOP_HPP
+
+#include <cstddef>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+/** The 26 directions of a 26-DOP, the polytope bounded by planes facing the
+faces, edges and corners of a cube. The first 4 point at the corners of a
+regular tetrahedron and the next 4 at the opposite corners, so that even a
+few leading directions spread around a cloud. Past those, each direction is
+followed by its opposite. */
+constexpr int dopDirections[26][3] = {
+    { 1, 1, 1 },   { 1, -1, -1 }, { -1, 1, -1 }, { -1, -1, 1 }, { -1, -1, -1 },
+    { -1, 1, 1 },  { 1, -1, 1 },  { 1, 1, -1 },  { 1, 0, 0 },   { -1, 0, 0 },
+    { 0, 1, 0 },   { 0, -1, 0 },  { 0, 0, 1 },   { 0, 0, -1 },  { 1, 1, 0 },
+    { -1, -1, 0 }, { 1, -1, 0 },  { -1, 1, 0 },  { 1, 0, 1 },   { -1, 0, -1 },
+    { 1, 0, -1 },  { -1, 0, 1 },  { 0, 1, 1 },   { 0, -1, -1 }, { 0, 1, -1 },
+    { 0, -1, 1 }
+};
+/** The index of one direction of each opposite pair, the 13 axes of the
+26-DOP, starting with the coordinate axes. */
+constexpr size_t dopAxes[13] = { 8ULL, 10ULL, 12ULL, 0ULL,  1ULL,  2ULL, 3ULL,
+                                 14ULL, 16ULL, 18ULL, 20ULL, 22ULL, 24ULL };
+};     // namespace Hull
+#endif // DOP_HPP
@@ -1,18 +1,154 @@
 #include "hull.hpp"
+#include "dop.hpp"
+#include "predicates.hpp"
+#include "profile.hpp"
+#include "random.hpp"
+#include "simd.hpp"
+#include "spatial.hpp"
+#include "threadPool.hpp"
+#include "workspace.hpp"
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstring>
+#include <limits>
 #include <numeric>
 #include <random>
 #include <tuple>
 
 // Forward Declarations
-std::vector<Hull::Triangle> init_hull3D(const std::vector<vec3>& pts);
+vec3 cloud_point(
+    const Hull::Philox& philox, const Hull::CloudOptions& options,
+    const std::vector<vec3>& centers, const size_t& index) noexcept;
+float signed_unit(const std::uint32_t& bits) noexcept;
+std::pair<float, float>
+normal_pair(const std::uint32_t& first, const std::uint32_t& second) noexcept;
+template <typename Scalar, typename Index>
+void build_hull(
+    const Hull::BasicPointSpan<Scalar>& unsortedPoints,
+    Hull::BasicWorkspace<Scalar, Index>& workspace,
+    const Hull::Options& options);
+template <typename Scalar, typename Index>
+void build_warm_hull(
+    const Hull::BasicPointSpan<Scalar>& unsortedPoints,
+    const std::vector<Index>& seeds,
+    Hull::BasicWorkspace<Scalar, Index>& workspace);
+template <typename Scalar, typename Index>
+void record_peaks(Hull::BasicWorkspace<Scalar, Index>& workspace) noexcept;
+template <typename Scalar, typename Index>
+Hull::BasicMesh<Index> finish_mesh(
+    Hull::BasicWorkspace<Scalar, Index>& workspace, Hull::Stats* stats);
+template <typename Scalar, typename Index>
+std::vector<Index>
+prefilter_points(const Hull::BasicPointSpan<Scalar>& points);
+template <typename Scalar, typename Index>
+std::vector<Index> parallel_hull_vertices(
+    const Hull::BasicPointSpan<Scalar>& points, std::vector<Index>& ids,
+    const Hull::Options& options, Hull::Stats& stats);
+template <typename Scalar, typename Index>
+std::vector<Index> hull_vertices(
+    const Hull::BasicPointSpan<Scalar>& points, const std::vector<Index>& ids,
+    const Hull::Options& options,
+    Hull::BasicWorkspace<Scalar, Index>& workspace);
+template <typename Scalar, typename Index>
+bool renumber_hull(std::vector<Hull::BasicTriangle<Scalar, Index>>& hull);
+template <typename Scalar, typename Index>
+bool append_triangles(
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Hull::Point<Scalar>>& points,
+    std::vector<Hull::Point<Scalar>>& vertices);
+template <typename Scalar, typename Index, typename Emit>
+bool emit_faces(
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Hull::Point<Scalar>>& points, Emit&& emit);
+template <typename Scalar, typename Index>
+Hull::BasicMesh<Index> build_mesh(
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Hull::Point<Scalar>>& points,
+    const std::vector<Index>& order);
+template <typename Scalar, typename Index>
+void run_engine(
+    const std::vector<Hull::Point<Scalar>>& pts, const Hull::Options& options,
+    Hull::BasicWorkspace<Scalar, Index>& workspace);
+template <typename Scalar, typename Index>
+void init_hull3D(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::InsertionOrder& insertion,
+    Hull::BasicWorkspace<Scalar, Index>& workspace, const Index& seedCount);
+template <typename Scalar, typename Index>
+bool quick_hull3D(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    Hull::BasicWorkspace<Scalar, Index>& workspace);
+template <typename Scalar, typename Index>
+bool initial_simplex(
+    const std::vector<Hull::Point<Scalar>>& pts, const Index& count,
+    std::array<Index, 4>& simplex) noexcept;
+template <typename Scalar, typename Index>
 void add_coplanar(
-    const std::vector<vec3>& pts, std::vector<Hull::Triangle>& hull,
-    const int& pointID);
-std::tuple<float, float, float, float> cross_test(
-    const std::vector<vec3>& pts, const int& triA, const int& triB,
-    const int& triC, const int& pointID) noexcept;
+    const std::vector<Hull::Point<Scalar>>& pts,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    Hull::BasicEdgeMap<Index>& edgeMap, const Index& pointID);
+template <typename Scalar, typename Index>
+std::tuple<Scalar, Scalar, Scalar, Scalar> cross_test(
+    const std::vector<Hull::Point<Scalar>>& pts, const Index& triA,
+    const Index& triB, const Index& triC, const Index& pointID) noexcept;
+template <typename Scalar, typename Index>
+void add_point(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    std::vector<Index>& freeSlots, std::vector<Index>& xList,
+    std::vector<Index>& newList, Hull::BasicEdgeMap<Index>& edgeMap,
+    const Index& pointID, const Index& hvis);
+template <typename Scalar, typename Index>
+void stitch_edge(
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    Hull::BasicEdgeMap<Index>& edgeMap, const Index& facet,
+    const Index& vertex, const bool& facing) noexcept;
+template <typename Scalar, typename Index>
+bool is_visible(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::BasicTriangle<Scalar, Index>& triangle,
+    const Hull::Point<Scalar>& point) noexcept;
+template <typename Scalar, typename Index>
+Scalar facet_offset(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::BasicTriangle<Scalar, Index>& triangle) noexcept;
+template <typename Scalar>
+Scalar coordinate_scale(const std::vector<Hull::Point<Scalar>>& pts) noexcept;
+template <typename Scalar, typename Index>
+void gather_planes(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Index>& facets, const Scalar& scale,
+    Hull::Simd::BasicPlanes<Scalar>& planes, std::vector<Scalar>& margins);
+template <typename Scalar, typename Index>
+Index find_visible(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Index>& facets,
+    const Hull::Simd::BasicPlanes<Scalar>& planes,
+    const std::vector<Scalar>& margins, const Hull::Point<Scalar>& point);
+template <typename Scalar>
+bool is_collinear(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c) noexcept;
+template <typename Scalar>
+Hull::Point<Scalar> facet_normal(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c) noexcept;
+template <typename Scalar, typename Index>
+bool winds_along_normal(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::BasicTriangle<Scalar, Index>& triangle) noexcept;
+
+// Seed for the insertion order, fixed so that hulls are reproducible.
+constexpr auto insertionSeed(0x5EED1234U);
+// Number of facet slots reserved up front, the pool grows past it on demand.
+constexpr size_t initialPoolSize(1024ULL);
+// Number of points each job generates when spread across threads.
+constexpr size_t cloudBlockSize(65536ULL);
+// Counter stream the centers of clustered clouds are drawn from.
+constexpr std::uint32_t centerStream(1U);
 
 std::vector<vec3> Hull::generate_point_cloud(
     const float& scale, const size_t& count, const unsigned int& seed) {
@@ -26,263 +162,1236 @@ std::vector<vec3> Hull::generate_point_cloud(
     return points;
 }
 
-std::vector<vec3>
-Hull::generate_convex_hull(const std::vector<vec3>& unsortedPoints) {
-    // Return early if not at-least a tetrahedron
-    if (unsortedPoints.size() < 4)
+std::vector<vec3> Hull::generate_point_cloud(
+    const size_t& count, const std::uint64_t& seed,
+    const CloudOptions& options) {
+    const Philox philox(seed);
+
+    // Place the clumps of a clustered cloud, from a stream of their own
+    std::vector<vec3> centers;
+    if (options.distribution == Distribution::Clustered) {
+        centers.resize(std::max<size_t>(options.clusters, 1ULL));
+        for (size_t i = 0ULL; i < centers.size(); ++i) {
+            const auto counter = static_cast<std::uint64_t>(i);
+            const auto block =
+                philox({ static_cast<std::uint32_t>(counter),
+                         static_cast<std::uint32_t>(counter >> 32U), 0U,
+                         centerStream });
+            centers[i] = vec3{ options.scale * signed_unit(block[0]),
+                               options.scale * signed_unit(block[1]),
+                               options.scale * signed_unit(block[2]) };
+        }
+    }
+
+    // Every point only depends on its index, so blocks can go in any order
+    std::vector<vec3> points(count);
+    const auto blocks = (count + cloudBlockSize - 1ULL) / cloudBlockSize;
+    const auto job = [&](const size_t& block) {
+        const auto last =
+            std::min<size_t>(count, (block + 1ULL) * cloudBlockSize);
+        for (auto i = block * cloudBlockSize; i < last; ++i)
+            points[i] = cloud_point(philox, options, centers, i);
+    };
+    if (options.threads > 1ULL && blocks > 1ULL) {
+        ThreadPool pool(std::min<size_t>(options.threads, blocks));
+        pool.run(blocks, job);
+    } else {
+        for (size_t block = 0ULL; block < blocks; ++block)
+            job(block);
+    }
+    return points;
+}
+
+template <typename Scalar>
+std::vector<Hull::Point<Scalar>> Hull::generate_convex_hull(
+    const std::vector<Point<Scalar>>& unsortedPoints, const Options& options,
+    Stats* stats) {
+    return generate_convex_hull(
+        BasicPointSpan<Scalar>{ unsortedPoints.data(), unsortedPoints.size() },
+        options, stats);
+}
+
+template <typename Scalar>
+std::vector<Hull::Point<Scalar>> Hull::generate_convex_hull(
+    const BasicPointSpan<Scalar>& unsortedPoints, const Options& options,
+    Stats* stats) {
+    // Keep the compact facet layout unless the pool could outgrow it
+    if (unsortedPoints.count > maxPoints<std::int32_t>) {
+        BasicWorkspace<Scalar, std::int64_t> workspace;
+        return generate_convex_hull(unsortedPoints, workspace, options, stats);
+    }
+    BasicWorkspace<Scalar, std::int32_t> workspace;
+    return generate_convex_hull(unsortedPoints, workspace, options, stats);
+}
+
+template <typename Scalar, typename Index>
+std::vector<Hull::Point<Scalar>> Hull::generate_convex_hull(
+    const BasicPointSpan<Scalar>& unsortedPoints,
+    BasicWorkspace<Scalar, Index>& workspace, const Options& options,
+    Stats* stats) {
+    // Return early if cannot create hull
+    if (unsortedPoints.count > maxPoints<Index>)
         return {};
+    build_hull(unsortedPoints, workspace, options);
+    auto clock = Profile::now();
+    std::vector<Point<Scalar>> vertices;
+    append_triangles(workspace.hull, workspace.points, vertices);
+    Profile::lap(workspace.stats.outputNs, clock);
+    if (stats != nullptr)
+        *stats = workspace.stats;
+    return vertices;
+}
+
+template <typename Scalar>
+size_t Hull::generate_convex_hull(
+    const BasicPointSpan<Scalar>& unsortedPoints,
+    const BasicFaceSink<Scalar>& sink, const Options& options, Stats* stats) {
+    // Keep the compact facet layout unless the pool could outgrow it
+    if (unsortedPoints.count > maxPoints<std::int32_t>) {
+        BasicWorkspace<Scalar, std::int64_t> workspace;
+        return generate_convex_hull(
+            unsortedPoints, workspace, sink, options, stats);
+    }
+    BasicWorkspace<Scalar, std::int32_t> workspace;
+    return generate_convex_hull(
+        unsortedPoints, workspace, sink, options, stats);
+}
+
+template <typename Scalar, typename Index>
+size_t Hull::generate_convex_hull(
+    const BasicPointSpan<Scalar>& unsortedPoints,
+    BasicWorkspace<Scalar, Index>& workspace,
+    const BasicFaceSink<Scalar>& sink, const Options& options, Stats* stats) {
+    // Return early if cannot create hull
+    if (unsortedPoints.count > maxPoints<Index>)
+        return 0ULL;
+    build_hull(unsortedPoints, workspace, options);
+    auto clock = Profile::now();
+    size_t faces(0ULL);
+    const auto closed = emit_faces(
+        workspace.hull, workspace.points,
+        [&sink, &faces](
+            const Point<Scalar>& a, const Point<Scalar>& b,
+            const Point<Scalar>& c) {
+            sink(a, b, c);
+            ++faces;
+        });
+    Profile::lap(workspace.stats.outputNs, clock);
+    if (stats != nullptr)
+        *stats = workspace.stats;
+    return closed ? faces : 0ULL;
+}
+
+Hull::HullBatch Hull::generate_convex_hulls(
+    const std::vector<PointSpan>& clouds, const Options& options) {
+    // Each hull runs on a single thread, spread across the pool
+    auto hullOptions(options);
+    hullOptions.threads = 0ULL;
+    const auto threads =
+        options.threads > 0ULL
+            ? options.threads
+            : std::max<size_t>(std::thread::hardware_concurrency(), 1ULL);
+    ThreadPool pool(threads);
 
-    // Sort points
-    auto points = unsortedPoints;
-    std::sort(points.begin(), points.end());
+    // Every thread reuses its own workspace, appending its hulls to its own
+    // output and noting where each one landed.
+    struct Scratch {
+        Workspace workspace;
+        std::vector<vec3> vertices;
+    };
+    std::vector<Scratch> scratch(pool.size());
+    std::vector<size_t> owner(clouds.size());
+    std::vector<size_t> start(clouds.size());
+    HullBatch batch;
+    batch.offsets.assign(clouds.size() + 1ULL, 0ULL);
+    pool.run(clouds.size(), [&](const size_t& cloud) {
+        const auto thread = ThreadPool::thread_index();
+        auto& buffers = scratch[thread];
+        owner[cloud] = thread;
+        start[cloud] = buffers.vertices.size();
+        auto& workspace = buffers.workspace;
+        build_hull(clouds[cloud], workspace, hullOptions);
+        append_triangles(workspace.hull, workspace.points, buffers.vertices);
+        batch.offsets[cloud + 1ULL] =
+            buffers.vertices.size() - start[cloud];
+    });
 
+    // Gather every hull into one buffer, in the order they were given
+    for (size_t cloud = 0ULL; cloud < clouds.size(); ++cloud)
+        batch.offsets[cloud + 1ULL] += batch.offsets[cloud];
+    batch.vertices.resize(batch.offsets.back());
+    pool.run(clouds.size(), [&](const size_t& cloud) {
+        const auto& vertices = scratch[owner[cloud]].vertices;
+        std::copy(
+            vertices.cbegin() + start[cloud],
+            vertices.cbegin() + start[cloud] +
+                (batch.offsets[cloud + 1ULL] - batch.offsets[cloud]),
+            batch.vertices.begin() + batch.offsets[cloud]);
+    });
+    return batch;
+}
+
+template <typename Index, typename Scalar>
+Hull::BasicMesh<Index> Hull::generate_convex_mesh(
+    const std::vector<Point<Scalar>>& unsortedPoints, const Options& options,
+    Stats* stats) {
+    return generate_convex_mesh<Index>(
+        BasicPointSpan<Scalar>{ unsortedPoints.data(), unsortedPoints.size() },
+        options, stats);
+}
+
+template <typename Index, typename Scalar>
+Hull::BasicMesh<Index> Hull::generate_convex_mesh(
+    const BasicPointSpan<Scalar>& unsortedPoints, const Options& options,
+    Stats* stats) {
+    BasicWorkspace<Scalar, Index> workspace;
+    return generate_convex_mesh(unsortedPoints, workspace, options, stats);
+}
+
+template <typename Index, typename Scalar>
+Hull::BasicMesh<Index> Hull::generate_convex_mesh(
+    const BasicPointSpan<Scalar>& unsortedPoints,
+    BasicWorkspace<Scalar, Index>& workspace, const Options& options,
+    Stats* stats) {
     // Return early if cannot create hull
-    auto tempHull = init_hull3D(points);
-    if (tempHull.empty())
+    if (unsortedPoints.count > maxPoints<Index>)
+        return {};
+    build_hull(unsortedPoints, workspace, options);
+    return finish_mesh(workspace, stats);
+}
+
+template <typename Index, typename Scalar>
+Hull::BasicMesh<Index> Hull::generate_convex_mesh(
+    const BasicPointSpan<Scalar>& unsortedPoints,
+    const std::vector<Index>& seeds, BasicWorkspace<Scalar, Index>& workspace,
+    Stats* stats) {
+    // Return early if cannot create hull
+    if (unsortedPoints.count > maxPoints<Index>)
+        return {};
+    build_warm_hull(unsortedPoints, seeds, workspace);
+    return finish_mesh(workspace, stats);
+}
+
+// Draw the point at an index of a generated cloud. Each point draws blocks
+// from counters of its own, the ball moving on to the next block whenever it
+// rejects a draw.
+vec3 cloud_point(
+    const Hull::Philox& philox, const Hull::CloudOptions& options,
+    const std::vector<vec3>& centers, const size_t& index) noexcept {
+    const auto low = static_cast<std::uint32_t>(index);
+    const auto high =
+        static_cast<std::uint32_t>(static_cast<std::uint64_t>(index) >> 32U);
+    const auto draw = [&](const std::uint32_t& round) {
+        return philox({ low, high, round, 0U });
+    };
+    const auto& scale = options.scale;
+    switch (options.distribution) {
+    case Hull::Distribution::Ball:
+        for (std::uint32_t round = 0U;; ++round) {
+            const auto block = draw(round);
+            const auto x = signed_unit(block[0]);
+            const auto y = signed_unit(block[1]);
+            const auto z = signed_unit(block[2]);
+            if (x * x + y * y + z * z <= 1.0F)
+                return vec3{ scale * x, scale * y, scale * z };
+        }
+    case Hull::Distribution::Sphere: {
+        const auto block = draw(0U);
+        const auto z = signed_unit(block[0]);
+        const auto angle = 6.28318531F * Hull::Philox::to_unit(block[1]);
+        const auto radius = std::sqrt(std::max(0.0F, 1.0F - z * z));
+        return vec3{ scale * radius * std::cos(angle),
+                     scale * radius * std::sin(angle), scale * z };
+    }
+    case Hull::Distribution::Gaussian: {
+        const auto block = draw(0U);
+        const auto [x, y] = normal_pair(block[0], block[1]);
+        const auto z = normal_pair(block[2], block[3]).first;
+        return vec3{ scale * x, scale * y, scale * z };
+    }
+    case Hull::Distribution::Clustered: {
+        const auto block = draw(0U);
+        const auto [x, y] = normal_pair(block[0], block[1]);
+        const auto z = normal_pair(block[2], block[3]).first;
+        const auto& center = centers[draw(1U)[0] % centers.size()];
+        const auto spread = scale * options.spread;
+        return vec3{ center.x() + spread * x, center.y() + spread * y,
+                     center.z() + spread * z };
+    }
+    case Hull::Distribution::Cube:
+    default: {
+        const auto block = draw(0U);
+        return vec3{ scale * signed_unit(block[0]),
+                     scale * signed_unit(block[1]),
+                     scale * signed_unit(block[2]) };
+    }
+    }
+}
+
+// Convert a random number to a float in [-1, 1).
+float signed_unit(const std::uint32_t& bits) noexcept {
+    return Hull::Philox::to_unit(bits) * 2.0F - 1.0F;
+}
+
+// Turn two random numbers into two independent standard normal numbers
+// (Box-Muller transform).
+std::pair<float, float>
+normal_pair(const std::uint32_t& first, const std::uint32_t& second) noexcept {
+    // Keep the logarithm finite by drawing from (0, 1] rather than [0, 1)
+    const auto unit = 1.0F - Hull::Philox::to_unit(first);
+    const auto radius = std::sqrt(-2.0F * std::log(unit));
+    const auto angle = 6.28318531F * Hull::Philox::to_unit(second);
+    return { radius * std::cos(angle), radius * std::sin(angle) };
+}
+
+// Sort the ids of the points and build a hull over a compact copy of those
+// that reach the engine, all in the workspace's buffers. The workspace's
+// stats are reset and record the build.
+template <typename Scalar, typename Index>
+void build_hull(
+    const Hull::BasicPointSpan<Scalar>& unsortedPoints,
+    Hull::BasicWorkspace<Scalar, Index>& workspace,
+    const Hull::Options& options) {
+    // Return early if not at-least a tetrahedron
+    auto& points = workspace.points;
+    auto& order = workspace.order;
+    auto& stats = workspace.stats;
+    stats = Hull::Stats{};
+    order.clear();
+    workspace.hull.clear();
+    if (unsortedPoints.count < 4)
+        return;
+
+    // Optionally drop the points that cannot be on the hull
+    auto clock = Hull::Profile::now();
+    if (options.prefilter)
+        order = prefilter_points<Scalar, Index>(unsortedPoints);
+    if (order.empty()) {
+        order.resize(unsortedPoints.count);
+        std::iota(order.begin(), order.end(), Index(0));
+    }
+    stats.culledPoints = unsortedPoints.count - order.size();
+    Hull::Profile::lap(stats.prefilterNs, clock);
+
+    // Sort points, remembering where each one came from. The slab engine
+    // instead narrows them down to the sorted hull vertices.
+    if (options.threads > 0ULL)
+        order = parallel_hull_vertices(unsortedPoints, order, options, stats);
+    else if (options.order != Hull::InsertionOrder::Sorted)
+        Hull::Spatial::morton_order(unsortedPoints, order, nullptr);
+    else
+        std::sort(
+            order.begin(), order.end(),
+            [&unsortedPoints](const Index& a, const Index& b) {
+                return unsortedPoints[a] < unsortedPoints[b];
+            });
+    points.resize(order.size());
+    std::transform(
+        order.cbegin(), order.cend(), points.begin(),
+        [&unsortedPoints](const Index& id) { return unsortedPoints[id]; });
+    Hull::Profile::lap(stats.sortNs, clock);
+
+    run_engine(points, options, workspace);
+    record_peaks(workspace);
+}
+
+// Build a hull with the points of some seeds inserted ahead of the rest,
+// such as the hull vertices of the previous frame of moving points. The hull
+// starts from the tetrahedron spanning the most of the seeds, and once the
+// seeds are in it leaves little room outside of it, so most of the other
+// points are found interior the first time they are filed or re-filed
+// rather than being inserted and retired later.
+template <typename Scalar, typename Index>
+void build_warm_hull(
+    const Hull::BasicPointSpan<Scalar>& unsortedPoints,
+    const std::vector<Index>& seeds,
+    Hull::BasicWorkspace<Scalar, Index>& workspace) {
+    // Return early if not at-least a tetrahedron
+    auto& points = workspace.points;
+    auto& order = workspace.order;
+    auto& stats = workspace.stats;
+    stats = Hull::Stats{};
+    order.clear();
+    workspace.hull.clear();
+    if (unsortedPoints.count < 4)
+        return;
+
+    // Put every distinct seed in range ahead of the other points
+    auto clock = Hull::Profile::now();
+    const auto count = static_cast<Index>(unsortedPoints.count);
+    auto& seeded = workspace.sequence;
+    seeded.assign(unsortedPoints.count, 0);
+    order.reserve(unsortedPoints.count);
+    for (const auto& seed : seeds) {
+        if (seed >= 0 && seed < count && seeded[seed] == 0) {
+            seeded[seed] = 1;
+            order.emplace_back(seed);
+        }
+    }
+    const auto seedCount = static_cast<Index>(order.size());
+    for (Index id = 0; id < count; ++id)
+        if (seeded[id] == 0)
+            order.emplace_back(id);
+    points.resize(order.size());
+    std::transform(
+        order.cbegin(), order.cend(), points.begin(),
+        [&unsortedPoints](const Index& id) { return unsortedPoints[id]; });
+
+    // Lead with the seed tetrahedron so the hull has volume straight away
+    std::array<Index, 4> simplex{};
+    if (seedCount >= 4 && initial_simplex(points, seedCount, simplex)) {
+        std::array<Index, 4> corners{};
+        for (size_t corner = 0ULL; corner < 4ULL; ++corner)
+            corners[corner] = order[simplex[corner]];
+        for (Index corner = 0; corner < 4; ++corner) {
+            const auto at = std::find(
+                order.begin() + corner, order.begin() + seedCount,
+                corners[corner]);
+            const auto position = static_cast<Index>(at - order.begin());
+            std::swap(order[corner], order[position]);
+            std::swap(points[corner], points[position]);
+        }
+    }
+    Hull::Profile::lap(stats.sortNs, clock);
+
+    init_hull3D(points, Hull::InsertionOrder::Sorted, workspace, seedCount);
+    record_peaks(workspace);
+}
+
+// Note the most facet slots and bytes a build held. The workspace keeps the
+// engine's buffers while the renumbering tables and output vertices are
+// allocated, so count both.
+template <typename Scalar, typename Index>
+void record_peaks(Hull::BasicWorkspace<Scalar, Index>& workspace) noexcept {
+    const auto& hull = workspace.hull;
+    const auto outputBytes =
+        hull.capacity() * (sizeof(Index) + sizeof(Hull::Point<Scalar>) * 3ULL);
+    workspace.stats.peakFacets = hull.size();
+    workspace.stats.peakBytes =
+        workspace.points.capacity() * sizeof(Hull::Point<Scalar>) +
+        workspace.order.capacity() * sizeof(Index) + workspace.engine_bytes() +
+        outputBytes;
+}
+
+// Renumber a built hull and convert it into an indexed mesh, reporting the
+// stats of its build.
+template <typename Scalar, typename Index>
+Hull::BasicMesh<Index> finish_mesh(
+    Hull::BasicWorkspace<Scalar, Index>& workspace, Hull::Stats* stats) {
+    auto clock = Hull::Profile::now();
+    const auto renumbered = renumber_hull(workspace.hull);
+    Hull::Profile::lap(workspace.stats.renumberNs, clock);
+
+    Hull::BasicMesh<Index> mesh;
+    if (renumbered)
+        mesh = build_mesh(workspace.hull, workspace.points, workspace.order);
+    Hull::Profile::lap(workspace.stats.outputNs, clock);
+    if (stats != nullptr)
+        *stats = workspace.stats;
+    return mesh;
+}
+
+// Find the points outside the polytope spanned by the extreme points along
+// the 13 axes of a 26-DOP, everything strictly inside it cannot be on the
+// hull (Akl-Toussaint heuristic). Returns the input index of each survivor,
+// or nothing if the extreme points are too degenerate to cull with.
+template <typename Scalar, typename Index>
+std::vector<Index>
+prefilter_points(const Hull::BasicPointSpan<Scalar>& points) {
+    // Copy the points into structure-of-arrays form for the kernel
+    const auto count = points.count;
+    std::vector<Scalar> xs(count);
+    std::vector<Scalar> ys(count);
+    std::vector<Scalar> zs(count);
+    for (size_t i = 0ULL; i < count; ++i) {
+        xs[i] = points[i].x();
+        ys[i] = points[i].y();
+        zs[i] = points[i].z();
+    }
+
+    // Find the lowest and highest point along each axis
+    std::vector<Index> extremes(26ULL, 0);
+    std::vector<Scalar> lowest(13ULL, std::numeric_limits<Scalar>::max());
+    std::vector<Scalar> highest(13ULL, std::numeric_limits<Scalar>::lowest());
+    for (size_t i = 0ULL; i < count; ++i) {
+        for (size_t axis = 0ULL; axis < 13ULL; ++axis) {
+            const auto* axes = Hull::dopDirections[Hull::dopAxes[axis]];
+            const auto distance = xs[i] * static_cast<Scalar>(axes[0]) +
+                                  ys[i] * static_cast<Scalar>(axes[1]) +
+                                  zs[i] * static_cast<Scalar>(axes[2]);
+            if (distance < lowest[axis]) {
+                lowest[axis] = distance;
+                extremes[axis * 2ULL] = static_cast<Index>(i);
+            }
+            if (distance > highest[axis]) {
+                highest[axis] = distance;
+                extremes[axis * 2ULL + 1ULL] = static_cast<Index>(i);
+            }
+        }
+    }
+    std::sort(extremes.begin(), extremes.end());
+    extremes.erase(
+        std::unique(extremes.begin(), extremes.end()), extremes.end());
+
+    // Build the inner polytope from the extreme points
+    std::vector<Hull::Point<Scalar>> extremePoints(extremes.size());
+    std::transform(
+        extremes.cbegin(), extremes.cend(), extremePoints.begin(),
+        [&points](const Index& id) { return points[id]; });
+    const auto inner = Hull::generate_convex_mesh(extremePoints);
+    if (inner.indices.empty())
         return {};
 
-    // Pick out the hull triangles and renumber.
-    const auto hullSize = tempHull.size();
-    std::vector<int> taken(hullSize, -1);
+    // Pull each face plane inwards a little, so that rounding can never
+    // cull a point lying on the hull. The margin scales with the precision
+    // of the coordinates, about 1e-5 of their extent for floats.
+    auto extent(Scalar(0));
+    for (size_t axis = 0ULL; axis < 3ULL; ++axis)
+        extent = std::max(
+            extent, std::max(std::abs(lowest[axis]), std::abs(highest[axis])));
+    const auto margin = Hull::Predicates::plane_margin(extent);
+    std::vector<Scalar> planes;
+    planes.reserve(inner.indices.size() / 3ULL * 4ULL);
+    for (size_t i = 0ULL; i < inner.indices.size(); i += 3ULL) {
+        const auto& v0 = extremePoints[inner.vertices[inner.indices[i]]];
+        const auto& v1 = extremePoints[inner.vertices[inner.indices[i + 1]]];
+        const auto& v2 = extremePoints[inner.vertices[inner.indices[i + 2]]];
+        const auto normal =
+            Hull::Point<Scalar>::normalize((v1 - v0).cross(v2 - v0));
+        planes.insert(
+            planes.end(),
+            { normal.x(), normal.y(), normal.z(), normal.dot(v0) - margin });
+    }
+
+    // Keep every point not strictly inside the inner polytope
+    std::vector<unsigned char> inside(count);
+    Hull::Simd::inside_planes(
+        xs.data(), ys.data(), zs.data(), count, planes.data(),
+        planes.size() / 4ULL, inside.data());
+    std::vector<Index> survivors;
+    for (size_t i = 0ULL; i < count; ++i)
+        if (inside[i] == 0)
+            survivors.emplace_back(static_cast<Index>(i));
+    return survivors;
+}
+
+// Find the hull vertices of a set of points by splitting it into slabs along
+// the sort order, finding each slab's hull vertices on its own thread, then
+// merging neighbouring slabs pairwise in a tree until one is left. Along a
+// Z-order curve the slabs are simply consecutive runs of the radix sorted
+// points. Returns the hull vertices in the insertion order's sort order, and
+// never depends on the thread count for points in general position.
+template <typename Scalar, typename Index>
+std::vector<Index> parallel_hull_vertices(
+    const Hull::BasicPointSpan<Scalar>& points, std::vector<Index>& ids,
+    const Hull::Options& options, Hull::Stats& stats) {
+    // Sort with ties broken by index so that any split sorts the same way
+    const auto less = [&points](const Index& a, const Index& b) {
+        if (points[a] < points[b])
+            return true;
+        return !(points[b] < points[a]) && a < b;
+    };
+
+    const auto sorted = options.order == Hull::InsertionOrder::Sorted;
+    const auto slabCount =
+        std::min<size_t>(options.threads, ids.size() / 4ULL);
+    if (slabCount < 1ULL) {
+        if (sorted)
+            std::sort(ids.begin(), ids.end(), less);
+        else
+            Hull::Spatial::morton_order(points, ids, nullptr);
+        return ids;
+    }
+
+    // Partition the points into one slab per thread by repeatedly splitting
+    // ranges of slabs in half, then sort each slab
+    Hull::ThreadPool pool(options.threads);
+    std::vector<size_t> bounds(slabCount + 1ULL);
+    for (size_t slab = 0ULL; slab <= slabCount; ++slab)
+        bounds[slab] = ids.size() * slab / slabCount;
+    std::vector<std::pair<size_t, size_t>> ranges{ { 0ULL, slabCount } };
+    if (!sorted) {
+        Hull::Spatial::morton_order(points, ids, &pool);
+        ranges.clear();
+    }
+    while (!ranges.empty() && ranges.size() < slabCount) {
+        pool.run(ranges.size(), [&](const size_t& range) {
+            const auto& [first, last] = ranges[range];
+            const auto middle = first + (last - first) / 2ULL;
+            if (middle > first)
+                std::nth_element(
+                    ids.begin() + bounds[first], ids.begin() + bounds[middle],
+                    ids.begin() + bounds[last], less);
+        });
+        std::vector<std::pair<size_t, size_t>> halves;
+        for (const auto& [first, last] : ranges) {
+            const auto middle = first + (last - first) / 2ULL;
+            if (middle > first)
+                halves.emplace_back(first, middle);
+            halves.emplace_back(middle, last);
+        }
+        ranges = halves;
+    }
+    // Each slab keeps its workspace for the merges it leads.
+    std::vector<std::vector<Index>> slabs(slabCount);
+    std::vector<Hull::BasicWorkspace<Scalar, Index>> workspaces(slabCount);
+    pool.run(slabCount, [&](const size_t& slab) {
+        auto& slabIDs = slabs[slab];
+        slabIDs.assign(
+            ids.begin() + bounds[slab], ids.begin() + bounds[slab + 1ULL]);
+        if (sorted)
+            std::sort(slabIDs.begin(), slabIDs.end(), less);
+        slabIDs = hull_vertices(points, slabIDs, options, workspaces[slab]);
+    });
+
+    // Merge neighbouring slabs, which stay sorted when joined end to end
+    for (size_t step = 1ULL; step < slabCount; step *= 2ULL) {
+        const auto pairCount = (slabCount + step * 2ULL - 1ULL) / (step * 2ULL);
+        pool.run(pairCount, [&](const size_t& pair) {
+            const auto left = pair * step * 2ULL;
+            const auto right = left + step;
+            if (right >= slabCount)
+                return;
+            auto& leftIDs = slabs[left];
+            leftIDs.insert(
+                leftIDs.end(), slabs[right].cbegin(), slabs[right].cend());
+            leftIDs = hull_vertices(points, leftIDs, options, workspaces[left]);
+            slabs[right].clear();
+        });
+    }
+    for (const auto& workspace : workspaces)
+        Hull::Profile::accumulate(stats, workspace.stats);
+    return slabs.front();
+}
+
+// Find the hull vertices among some sorted points, keeping their order.
+// Every point is kept if they cannot form a hull.
+template <typename Scalar, typename Index>
+std::vector<Index> hull_vertices(
+    const Hull::BasicPointSpan<Scalar>& points, const std::vector<Index>& ids,
+    const Hull::Options& options,
+    Hull::BasicWorkspace<Scalar, Index>& workspace) {
+    if (ids.size() < 4ULL)
+        return ids;
+    auto& sortedPoints = workspace.points;
+    sortedPoints.resize(ids.size());
+    std::transform(
+        ids.cbegin(), ids.cend(), sortedPoints.begin(),
+        [&points](const Index& id) { return points[id]; });
+    run_engine(sortedPoints, options, workspace);
+    if (!renumber_hull(workspace.hull))
+        return ids;
+
+    std::vector<unsigned char> used(ids.size(), 0);
+    for (const auto& triangle : workspace.hull) {
+        if (triangle.keep > 0) {
+            used[triangle.a] = 1;
+            used[triangle.b] = 1;
+            used[triangle.c] = 1;
+        }
+    }
+    std::vector<Index> vertices;
+    for (size_t i = 0ULL; i < ids.size(); ++i)
+        if (used[i] != 0)
+            vertices.emplace_back(ids[i]);
+    return vertices;
+}
+
+// Append the triangles of a hull to a triangle soup, appending nothing if
+// the hull is not closed.
+template <typename Scalar, typename Index>
+bool append_triangles(
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Hull::Point<Scalar>>& points,
+    std::vector<Hull::Point<Scalar>>& vertices) {
+    using Point = Hull::Point<Scalar>;
+    const auto first = vertices.size();
+    vertices.reserve(first + hull.size() * 3ULL);
+    const auto closed = emit_faces(
+        hull, points,
+        [&vertices](const Point& a, const Point& b, const Point& c) {
+            vertices.emplace_back(a);
+            vertices.emplace_back(b);
+            vertices.emplace_back(c);
+        });
+    if (!closed)
+        vertices.resize(first);
+    return closed;
+}
+
+// Hand every live facet of a hull to 'emit' as its 3 points, wound
+// counter-clockwise around the outward normal it was built with. Returns
+// false, stopping early, if there is no hull or a facet borders a retired
+// one.
+template <typename Scalar, typename Index, typename Emit>
+bool emit_faces(
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Hull::Point<Scalar>>& points, Emit&& emit) {
+    if (hull.empty())
+        return false;
+    for (const auto& temp : hull) {
+        if (temp.keep <= 0)
+            continue;
+        if (hull[temp.ab].keep <= 0 || hull[temp.bc].keep <= 0 ||
+            hull[temp.ac].keep <= 0)
+            return false;
+        if (winds_along_normal(points, temp))
+            emit(points[temp.a], points[temp.b], points[temp.c]);
+        else
+            emit(points[temp.a], points[temp.c], points[temp.b]);
+    }
+    return true;
+}
+
+// Give the live facets of a hull and their neighbours compact ids, in order.
+template <typename Scalar, typename Index>
+bool renumber_hull(std::vector<Hull::BasicTriangle<Scalar, Index>>& hull) {
+    if (hull.empty())
+        return false;
 
     // Create an index from old triangle-id to new triangle-id.
-    std::vector<vec3> vertices;
-    vertices.reserve(hullSize * 3ULL);
-    int count(0);
+    const auto hullSize = hull.size();
+    std::vector<Index> taken(hullSize, -1);
+    Index count(0);
     for (size_t t = 0ULL; t < hullSize; ++t)
-        if (tempHull[t].keep > 0)
+        if (hull[t].keep > 0)
             taken[t] = count++;
     for (size_t t = 0ULL; t < hullSize; ++t) {
-        auto& temp = tempHull[t];
+        auto& temp = hull[t];
         if (temp.keep > 0) {
             if (taken[temp.ab] < 0 || taken[temp.bc] < 0 || taken[temp.ac] < 0)
-                return {};
+                return false;
 
             temp.id = taken[t];
             temp.ab = taken[temp.ab];
             temp.bc = taken[temp.bc];
             temp.ac = taken[temp.ac];
-
-            vertices.emplace_back(points[temp.a]);
-            vertices.emplace_back(points[temp.b]);
-            vertices.emplace_back(points[temp.c]);
         }
     }
+    return true;
+}
 
-    // Ensure all normals point outwards
-    const auto center =
-        std::accumulate(vertices.cbegin(), vertices.cend(), vec3(0.0F)) /
-        vec3(static_cast<float>(vertices.size()));
-    for (size_t i = 0ULL; i < vertices.size() - 3ULL; i += 3ULL) {
-        const auto& v0 = vertices[i];
-        const auto& v1 = vertices[i + 1];
-        const auto& v2 = vertices[i + 2];
-        const auto normalDirection =
-            vec3::normalize(vec3::cross(v1 - v0, v2 - v0));
-        const auto triCenter = (v0 + v1 + v2) / vec3(3.0F);
-        const auto centerDirection = vec3::normalize(triCenter - center);
+// Build a hull over sorted points with the selected engine, into the
+// workspace's facet pool. Points that do not span a volume always go through
+// the incremental builder, which can hull them in the plane.
+template <typename Scalar, typename Index>
+void run_engine(
+    const std::vector<Hull::Point<Scalar>>& pts, const Hull::Options& options,
+    Hull::BasicWorkspace<Scalar, Index>& workspace) {
+    if (options.algorithm == Hull::Algorithm::QuickHull &&
+        quick_hull3D(pts, workspace))
+        return;
+    init_hull3D(pts, options.order, workspace, Index(0));
+}
 
-        // Compare angle between both directions
-        const auto angle = normalDirection.dot(centerDirection);
+// Convert a renumbered hull into an indexed mesh. 'order' maps each point
+// back to its input index, or is empty if the points are in input order.
+template <typename Scalar, typename Index>
+Hull::BasicMesh<Index> build_mesh(
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Hull::Point<Scalar>>& points,
+    const std::vector<Index>& order) {
+    // Give every hull vertex a compact id the first time a face uses it.
+    Hull::BasicMesh<Index> mesh;
+    std::vector<Index> vertexMap(points.size(), -1);
+    const auto vertex_id = [&mesh, &vertexMap, &order](const Index& pointID) {
+        if (vertexMap[pointID] < 0) {
+            vertexMap[pointID] = static_cast<Index>(mesh.vertices.size());
+            mesh.vertices.emplace_back(
+                order.empty() ? pointID : order[pointID]);
+        }
+        return vertexMap[pointID];
+    };
 
-        // Swap vertices if normal direction points closer towards center
-        if (angle < 0.0F)
-            std::swap(vertices[i + 1], vertices[i + 2]);
+    // Wind each face so that its stored outward normal faces the viewer.
+    mesh.indices.reserve(hull.size() * 3ULL);
+    mesh.adjacency.reserve(hull.size() * 3ULL);
+    for (const auto& temp : hull) {
+        if (temp.keep > 0) {
+            const auto a = vertex_id(temp.a);
+            const auto b = vertex_id(temp.b);
+            const auto c = vertex_id(temp.c);
+            if (winds_along_normal(points, temp)) {
+                mesh.indices.insert(mesh.indices.end(), { a, b, c });
+                mesh.adjacency.insert(
+                    mesh.adjacency.end(), { temp.ab, temp.bc, temp.ac });
+            } else {
+                mesh.indices.insert(mesh.indices.end(), { a, c, b });
+                mesh.adjacency.insert(
+                    mesh.adjacency.end(), { temp.ac, temp.bc, temp.ab });
+            }
+        }
     }
-
-    return vertices;
+    return mesh;
 }
 
 // Initialize the hull to the point where there is a non-zero volume hull.
-std::vector<Hull::Triangle> init_hull3D(const std::vector<vec3>& pts) {
-    // Check for co-linearity
-    const auto& point0(pts[0]);
-    const auto& point1(pts[1]);
-    const auto& point2(pts[2]);
-    const auto test1 = point1 - point0;
-    const auto test2 = point2 - point0;
-    const auto cross = test1.cross(test2);
-
-    // Avoid adding facets
-    if (cross.x() == 0.0F && cross.y() == 0.0F && cross.z() == 0.0F)
-        return {};
+// The first 'seedCount' points get inserted ahead of the others.
+template <typename Scalar, typename Index>
+void init_hull3D(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::InsertionOrder& insertion,
+    Hull::BasicWorkspace<Scalar, Index>& workspace, const Index& seedCount) {
+    using Triangle = Hull::BasicTriangle<Scalar, Index>;
+    auto& hull = workspace.hull;
+    auto& edgeMap = workspace.edgeMap;
+    auto& stats = workspace.stats;
+    auto clock = Hull::Profile::now();
+    hull.clear();
 
-    // Adjacent facet id number
-    std::vector<Hull::Triangle> hull;
-    hull.reserve(pts.size() * 4ULL);
-    hull.emplace_back(Hull::Triangle{ 0, 1, 0, 1, 2, 1, 1, 1, cross.x(),
-                                      cross.y(), cross.z() });
-    hull.emplace_back(Hull::Triangle{ 1, 1, 0, 1, 2, 0, 0, 0, -cross.x(),
-                                      -cross.y(), -cross.z() });
-
-    // Add points until a non coplanar set of points is achieved.
-    std::vector<int> xList;
-    auto pointSum(point0 + point1 + point2);
-    const auto maxPts(static_cast<int>(pts.size()));
-    for (int pointID = 3; pointID < maxPts; ++pointID) {
+    // Seed the flat hull with a triangle. Leading points that are duplicates
+    // or collinear are spanned by the two ends of their line, and the points
+    // between those ends cannot be hull vertices.
+    const auto maxPts(static_cast<Index>(pts.size()));
+    Index pointID = 1;
+    while (pointID < maxPts && pts[pointID] == pts[0])
+        ++pointID;
+    const auto lineID = pointID;
+    while (pointID < maxPts && is_collinear(pts[0], pts[lineID], pts[pointID]))
+        ++pointID;
+    if (pointID >= maxPts)
+        return;
+    const auto line = pts[lineID] - pts[0];
+    Index first(0);
+    Index last(0);
+    for (Index id = 1; id < pointID; ++id) {
+        if (line.dot(pts[id] - pts[first]) < Scalar(0))
+            first = id;
+        if (line.dot(pts[id] - pts[last]) > Scalar(0))
+            last = id;
+    }
+    const auto& point0(pts[first]);
+    const auto& point1(pts[last]);
+    const auto& point2(pts[pointID]);
+    const auto cross = facet_normal(point0, point1, point2);
+
+    // Adjacent facet id number, retired facet slots are recycled through a
+    // free list so the pool tracks the live hull rather than the input.
+    auto& freeSlots = workspace.freeSlots;
+    freeSlots.clear();
+    hull.reserve(std::min<size_t>(pts.size() * 2ULL, initialPoolSize));
+    hull.emplace_back(Triangle{ 0, 1, first, last, pointID, 1, 1, 1,
+                                cross.x(), cross.y(), cross.z() });
+    hull.emplace_back(Triangle{ 1, 1, first, last, pointID, 0, 0, 0,
+                                -cross.x(), -cross.y(), -cross.z() });
+    Hull::Profile::tally(stats.facetsCreated, 2ULL);
+
+    // Add points in sorted order until a non coplanar set of points is
+    // achieved, the hull is still flat so a linear scan is cheap.
+    auto& xList = workspace.xList;
+    auto& newList = workspace.newList;
+    for (++pointID; pointID < maxPts; ++pointID) {
         const auto& point(pts[pointID]);
-        pointSum = pointSum + point;
-        const auto middle(pointSum / vec3(1.0F + static_cast<float>(pointID)));
-        xList.clear();
-        int hvis(-1);
 
         // Find the first visible plane.
-        for (int hullID = static_cast<int>(hull.size() - 1ULL); hullID >= 0;
+        Index hvis(-1);
+        for (auto hullID = static_cast<Index>(hull.size() - 1ULL); hullID >= 0;
              --hullID) {
-            auto& triangle = hull[hullID];
-            const auto delta = point - pts[triangle.a];
-            if ((delta.x() * triangle.er) + (delta.y() * triangle.ec) +
-                    (delta.z() * triangle.ez) >
-                0.0F) {
+            if (is_visible(pts, hull[hullID], point)) {
                 hvis = hullID;
-                triangle.keep = 0;
-                xList.emplace_back(hvis);
                 break;
             }
         }
-        if (hvis < 0)
-            add_coplanar(pts, hull, pointID);
-        else if (hvis >= 0) {
-            // New triangular facets formed from neighbouring invisible planes
-            const auto hullSizeStart = static_cast<int>(hull.size());
-            auto numx = static_cast<int>(xList.size());
-            const auto facet_adjacent = [&hull, &pts, &point, &xList, &pointID,
-                                         &numx, &middle](
-                                            const auto& hullID,
-                                            const auto& triX, const auto& triY,
-                                            auto& triXY) {
-                // Point on next triangle
-                auto delta(point - pts[triXY.a]);
-                if ((delta.x() * triXY.er) + (delta.y() * triXY.ec) +
-                        (delta.z() * triXY.ez) >
-                    0.0F) {
-                    // Add to list.
-                    if (triXY.keep == 1) {
-                        triXY.keep = 0;
-                        xList.emplace_back(hullID);
-                        numx++;
-                    }
-                } else {
-                    // make normal vector.
-                    Hull::Triangle Tnew{ static_cast<int>(hull.size()),
-                                         2,
-                                         pointID,
-                                         triX,
-                                         triY,
-                                         -1,
-                                         hullID,
-                                         -1 };
-                    const auto dTest1 = pts[Tnew.a] - pts[Tnew.b];
-                    const auto dTest2 = pts[Tnew.a] - pts[Tnew.c];
-                    const auto dCross = dTest1.cross(dTest2);
-
-                    // points from new facet towards 'middle'
-                    delta = middle - point;
-
-                    // make it point outwards.
-                    if ((delta.x() * dCross.x()) + (delta.y() * dCross.y()) +
-                            (delta.z() * dCross.z()) >
-                        0.0F) {
-                        Tnew.er = -dCross.x();
-                        Tnew.ec = -dCross.y();
-                        Tnew.ez = -dCross.z();
-                    } else {
-                        Tnew.er = dCross.x();
-                        Tnew.ec = dCross.y();
-                        Tnew.ez = dCross.z();
-                    }
-
-                    // update the touching triangle
-                    if ((triXY.a == triX && triXY.b == triY) ||
-                        (triXY.a == triY && triXY.b == triX))
-                        triXY.ab = static_cast<int>(hull.size());
-                    else if (
-                        (triXY.a == triX && triXY.c == triY) ||
-                        (triXY.a == triY && triXY.c == triX))
-                        triXY.ac = static_cast<int>(hull.size());
-                    else if (
-                        (triXY.b == triX && triXY.c == triY) ||
-                        (triXY.b == triY && triXY.c == triX))
-                        triXY.bc = static_cast<int>(hull.size());
-
-                    // spawn a new triangle.
-                    hull.emplace_back(Tnew);
+        Hull::Profile::tally(stats.visibilityTests);
+        if (hvis < 0) {
+            const auto facetCount = hull.size();
+            add_coplanar(pts, hull, edgeMap, pointID);
+            Hull::Profile::tally(stats.coplanarPoints);
+            Hull::Profile::tally(stats.facetsCreated, hull.size() - facetCount);
+        } else {
+            add_point(
+                pts, hull, freeSlots, xList, newList, edgeMap, pointID, hvis);
+            Hull::Profile::insertion(stats, newList.size(), xList.size());
+            freeSlots.insert(freeSlots.end(), xList.cbegin(), xList.cend());
+            break;
+        }
+    }
+    Hull::Profile::lap(stats.flatNs, clock);
+    if (pointID >= maxPts)
+        return;
+
+    // The hull now has volume. Every remaining point gets filed under one
+    // facet it can see, and each facet heads a linked list of the points
+    // filed under it.
+    auto& facetPoints = workspace.facetPoints;
+    auto& pointFacet = workspace.pointFacet;
+    auto& nextPoint = workspace.nextPoint;
+    facetPoints.assign(hull.size(), -1);
+    pointFacet.assign(pts.size(), -1);
+    nextPoint.assign(pts.size(), -1);
+    const auto file_point = [&facetPoints, &pointFacet, &nextPoint](
+                                const Index& id, const Index& hullID) {
+        pointFacet[id] = hullID;
+        nextPoint[id] = facetPoints[hullID];
+        facetPoints[hullID] = id;
+    };
+
+    // Insert the remaining points in a fixed random order, keeping the
+    // expected amount of conflict re-filing at O(n log n). Points already
+    // along a Z-order curve are either kept in it, or split into biased
+    // random rounds that keep the curve's locality within each round.
+    // Seeds keep their lead, shuffled among themselves.
+    auto& order = workspace.sequence;
+    order.resize(static_cast<size_t>(maxPts - pointID - 1));
+    std::iota(order.begin(), order.end(), static_cast<Index>(pointID + 1));
+    const auto seedEnd =
+        order.begin() + std::max<Index>(seedCount - pointID - 1, 0);
+    if (insertion == Hull::InsertionOrder::Sorted) {
+        std::mt19937 generator(insertionSeed);
+        std::shuffle(order.begin(), seedEnd, generator);
+        std::shuffle(seedEnd, order.end(), generator);
+    } else if (insertion == Hull::InsertionOrder::Biased)
+        Hull::Spatial::biased_order(order, insertionSeed);
+    auto& candidates = workspace.facets;
+    candidates.clear();
+    for (Index hullID = 0; hullID < static_cast<Index>(hull.size()); ++hullID)
+        if (hull[hullID].keep > 0)
+            candidates.emplace_back(hullID);
+    const auto scale = coordinate_scale(pts);
+    auto& planes = workspace.planes;
+    auto& margins = workspace.margins;
+    gather_planes(pts, hull, candidates, scale, planes, margins);
+    for (const auto& id : order) {
+        const auto hullID =
+            find_visible(pts, hull, candidates, planes, margins, pts[id]);
+        if (hullID >= 0)
+            file_point(id, hullID);
+    }
+    Hull::Profile::tally(stats.visibilityTests, order.size());
+    Hull::Profile::lap(stats.fileNs, clock);
+
+    for (const auto& id : order) {
+        // Points no facet can see are inside the hull, discard them.
+        const auto hvis = pointFacet[id];
+        if (hvis < 0) {
+            Hull::Profile::tally(stats.pointsInterior);
+            continue;
+        }
+
+        add_point(pts, hull, freeSlots, xList, newList, edgeMap, id, hvis);
+        Hull::Profile::insertion(stats, newList.size(), xList.size());
+        facetPoints.resize(hull.size(), -1);
+
+        // Re-file the points of every retired facet under a new facet.
+        gather_planes(pts, hull, newList, scale, planes, margins);
+        for (const auto& deadID : xList) {
+            auto pending = facetPoints[deadID];
+            facetPoints[deadID] = -1;
+            while (pending >= 0) {
+                const auto next = nextPoint[pending];
+                pointFacet[pending] = -1;
+                if (pending != id) {
+                    const auto hullID = find_visible(
+                        pts, hull, newList, planes, margins, pts[pending]);
+                    Hull::Profile::tally(stats.visibilityTests);
+                    if (hullID >= 0)
+                        file_point(pending, hullID);
                 }
-            };
-            for (int x = 0; x < numx; ++x) {
-                const auto hullX(hull[xList[x]]);
-                facet_adjacent(hullX.ab, hullX.a, hullX.b, hull[hullX.ab]);
-                facet_adjacent(hullX.ac, hullX.a, hullX.c, hull[hullX.ac]);
-                facet_adjacent(hullX.bc, hullX.b, hullX.c, hull[hullX.bc]);
+                pending = next;
             }
+        }
 
-            // Patch up the new triangles in hull.
-            const auto hullSizeEnd = static_cast<int>(hull.size());
-            std::vector<Hull::Snork> norts;
-            norts.reserve(hullSizeEnd + 1ULL);
-            for (int hullID = hullSizeEnd - 1; hullID >= hullSizeStart;
-                 --hullID) {
-                if (hull[hullID].keep > 1) {
-                    norts.emplace_back(
-                        Hull::Snork{ hullID, hull[hullID].b, 1 });
-                    norts.emplace_back(
-                        Hull::Snork{ hullID, hull[hullID].c, 0 });
-                    hull[hullID].keep = 1;
-                }
+        // The retired facets are no longer referenced, recycle their slots.
+        freeSlots.insert(freeSlots.end(), xList.cbegin(), xList.cend());
+    }
+    Hull::Profile::lap(stats.insertNs, clock);
+}
+
+// Add a point that can see facet 'hvis', retiring every facet it can see
+// and stitching new facets to the horizon. Retired facet ids end up in
+// 'xList' and new facet ids in 'newList', new facets take recycled slots
+// from 'freeSlots' before growing the pool. 'edgeMap' is scratch space for
+// pairing up the edges of the new facets.
+template <typename Scalar, typename Index>
+void add_point(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    std::vector<Index>& freeSlots, std::vector<Index>& xList,
+    std::vector<Index>& newList, Hull::BasicEdgeMap<Index>& edgeMap,
+    const Index& pointID, const Index& hvis) {
+    using Triangle = Hull::BasicTriangle<Scalar, Index>;
+    const auto& point(pts[pointID]);
+    hull[hvis].keep = 0;
+    xList.clear();
+    xList.emplace_back(hvis);
+    newList.clear();
+
+    // New triangular facets formed from neighbouring invisible planes
+    auto numx = static_cast<Index>(xList.size());
+    const auto facet_adjacent = [&hull, &freeSlots, &newList, &pts, &point,
+                                 &xList, &pointID, &numx](
+                                    const auto& hullID, const auto& triX,
+                                    const auto& triY, auto& triXY) {
+        // Point on next triangle
+        if (is_visible(pts, triXY, point)) {
+            // Add to list.
+            if (triXY.keep == 1) {
+                triXY.keep = 0;
+                xList.emplace_back(hullID);
+                numx++;
             }
-            if (norts.size() < 2ULL)
-                continue;
-
-            // Sort and link triangle sides.
-            std::sort(norts.begin(), norts.end());
-            for (auto nort = norts.cbegin(), nortNext = std::next(nort);
-                 nortNext < norts.cend(); ++nort, ++nortNext) {
-                if (nort->a == nortNext->a) {
-                    if (nort->b == 1)
-                        hull[nort->id].ab = nortNext->id;
-                    else
-                        hull[nort->id].ac = nortNext->id;
-                    if (nortNext->b == 1)
-                        hull[nortNext->id].ab = nort->id;
-                    else
-                        hull[nortNext->id].ac = nort->id;
-                }
+        } else {
+            // make normal vector.
+            const auto slot = freeSlots.empty()
+                                  ? static_cast<Index>(hull.size())
+                                  : freeSlots.back();
+            Triangle Tnew{ slot,
+                           2,
+                           pointID,
+                           triX,
+                           triY,
+                           -1,
+                           hullID,
+                           -1 };
+            const auto dCross =
+                facet_normal(point, pts[Tnew.b], pts[Tnew.c]);
+
+            // make it point outwards, away from the far corner of the
+            // facet behind it. If the two facets are coplanar they share
+            // the same outward side instead.
+            const auto far = triXY.a != triX && triXY.a != triY ? triXY.a
+                             : triXY.b != triX && triXY.b != triY
+                                 ? triXY.b
+                                 : triXY.c;
+            const auto side = Hull::Predicates::orient3d(
+                point, pts[Tnew.b], pts[Tnew.c], pts[far]);
+            const auto flip =
+                side == 0.0 ? dCross.dot(Hull::Point<Scalar>(
+                                  triXY.er, triXY.ec, triXY.ez)) < Scalar(0)
+                            : side < 0.0;
+            if (flip) {
+                Tnew.er = -dCross.x();
+                Tnew.ec = -dCross.y();
+                Tnew.ez = -dCross.z();
+            } else {
+                Tnew.er = dCross.x();
+                Tnew.ec = dCross.y();
+                Tnew.ez = dCross.z();
             }
+
+            // update the touching triangle
+            if ((triXY.a == triX && triXY.b == triY) ||
+                (triXY.a == triY && triXY.b == triX))
+                triXY.ab = slot;
+            else if (
+                (triXY.a == triX && triXY.c == triY) ||
+                (triXY.a == triY && triXY.c == triX))
+                triXY.ac = slot;
+            else if (
+                (triXY.b == triX && triXY.c == triY) ||
+                (triXY.b == triY && triXY.c == triX))
+                triXY.bc = slot;
+
+            // spawn a new triangle, reusing a retired slot when possible.
+            if (freeSlots.empty())
+                hull.emplace_back(Tnew);
+            else {
+                freeSlots.pop_back();
+                hull[slot] = Tnew;
+            }
+            newList.emplace_back(slot);
         }
+    };
+    for (Index x = 0; x < numx; ++x) {
+        const auto hullX(hull[xList[x]]);
+        facet_adjacent(hullX.ab, hullX.a, hullX.b, hull[hullX.ab]);
+        facet_adjacent(hullX.ac, hullX.a, hullX.c, hull[hullX.ac]);
+        facet_adjacent(hullX.bc, hullX.b, hullX.c, hull[hullX.bc]);
+    }
+
+    // Patch up the new triangles in hull.
+    edgeMap.reset(newList.size() * 2ULL);
+    for (const auto& hullID : newList) {
+        if (hull[hullID].keep > 1) {
+            stitch_edge(hull, edgeMap, hullID, hull[hullID].b, false);
+            stitch_edge(hull, edgeMap, hullID, hull[hullID].c, false);
+            hull[hullID].keep = 1;
+        }
+    }
+}
+
+// Test if a point lies strictly in front of a facet. The stored normal only
+// picks which side is the front, the side the point is on is found exactly.
+template <typename Scalar, typename Index>
+bool is_visible(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::BasicTriangle<Scalar, Index>& triangle,
+    const Hull::Point<Scalar>& point) noexcept {
+    const auto& pointA = pts[triangle.a];
+    const auto& pointB = pts[triangle.b];
+    const auto& pointC = pts[triangle.c];
+    const auto side = Hull::Predicates::orient3d(pointA, pointB, pointC, point);
+    if (side == 0.0)
+        return false;
+    return winds_along_normal(pts, triangle) == (side < 0.0);
+}
+
+// Find the offset of a facet's plane along its normal.
+template <typename Scalar, typename Index>
+Scalar facet_offset(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::BasicTriangle<Scalar, Index>& triangle) noexcept {
+    const auto& point = pts[triangle.a];
+    return (point.x() * triangle.er + point.y() * triangle.ec) +
+           point.z() * triangle.ez;
+}
+
+// Find a facet among 'facets' that a point can see. The vectorized plane test
+// settles every point clearly above or behind a facet, and the exact test
+// only runs for points within the rounding margin of its plane.
+template <typename Scalar, typename Index>
+Index find_visible(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Index>& facets,
+    const Hull::Simd::BasicPlanes<Scalar>& planes,
+    const std::vector<Scalar>& margins, const Hull::Point<Scalar>& point) {
+    const auto found =
+        Hull::Simd::first_above(planes, point.x(), point.y(), point.z());
+    if (found < 0)
+        return -1;
+    const auto facetCount = facets.size();
+    for (auto i = static_cast<size_t>(found); i < facetCount; ++i) {
+        const auto above =
+            ((point.x() * planes.x[i] + point.y() * planes.y[i]) +
+             point.z() * planes.z[i]) -
+            planes.offset[i];
+        if (above <= Scalar(0))
+            continue;
+        if (above > Scalar(2) * margins[i] ||
+            is_visible(pts, hull[facets[i]], point))
+            return facets[i];
+    }
+    return -1;
+}
+
+// Test if 3 points lie exactly on one line.
+template <typename Scalar>
+bool is_collinear(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c) noexcept {
+    return Hull::Predicates::orient2d(a, b, c, 0) == 0.0 &&
+           Hull::Predicates::orient2d(a, b, c, 1) == 0.0 &&
+           Hull::Predicates::orient2d(a, b, c, 2) == 0.0;
+}
+
+// Find the normal of the plane through 3 points, wound counter-clockwise.
+// Its components are the turns the points make seen along each axis, so
+// unlike a rounded cross product their signs are exact, and only thin
+// triangles of points that are all collinear get a zero normal.
+template <typename Scalar>
+Hull::Point<Scalar> facet_normal(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c) noexcept {
+    return Hull::Point<Scalar>(
+        static_cast<Scalar>(Hull::Predicates::orient2d(a, b, c, 0)),
+        static_cast<Scalar>(Hull::Predicates::orient2d(a, b, c, 1)),
+        static_cast<Scalar>(Hull::Predicates::orient2d(a, b, c, 2)));
+}
+
+// Check if a facet's normal faces the side its vertices wind around, by
+// comparing the sign of its largest component with the exact turn.
+template <typename Scalar, typename Index>
+bool winds_along_normal(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::BasicTriangle<Scalar, Index>& triangle) noexcept {
+    const std::array<Scalar, 3> normal{ triangle.er, triangle.ec,
+                                        triangle.ez };
+    const auto axis = static_cast<int>(
+        std::max_element(
+            normal.cbegin(), normal.cend(),
+            [](const Scalar& a, const Scalar& b) {
+                return std::abs(a) < std::abs(b);
+            }) -
+        normal.cbegin());
+    const auto turn = Hull::Predicates::orient2d(
+        pts[triangle.a], pts[triangle.b], pts[triangle.c], axis);
+    return (turn > 0.0) == (normal[axis] > Scalar(0));
+}
+
+// Find the largest magnitude of any coordinate of some points.
+template <typename Scalar>
+Scalar coordinate_scale(const std::vector<Hull::Point<Scalar>>& pts) noexcept {
+    auto scale(Scalar(0));
+    for (const auto& point : pts)
+        scale = std::max(
+            { scale, std::abs(point.x()), std::abs(point.y()),
+              std::abs(point.z()) });
+    return scale;
+}
+
+// Copy the planes of some facets into structure-of-arrays form, so that
+// points can be tested against all of them at once. Each plane is lowered
+// by twice the worst rounding error of the plane test against it, for
+// points whose coordinates are at most 'scale' in magnitude. That error
+// comes from the rounding of the stored normal, bounded by the facet's
+// longest edge, and from evaluating the test itself.
+template <typename Scalar, typename Index>
+void gather_planes(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Index>& facets, const Scalar& scale,
+    Hull::Simd::BasicPlanes<Scalar>& planes, std::vector<Scalar>& margins) {
+    planes.clear();
+    margins.clear();
+    for (const auto& hullID : facets) {
+        const auto& triangle = hull[hullID];
+        const auto& pointA = pts[triangle.a];
+        const auto& pointB = pts[triangle.b];
+        const auto& pointC = pts[triangle.c];
+        auto edge(Scalar(0));
+        for (const auto& delta :
+             { pointB - pointA, pointC - pointA, pointC - pointB })
+            edge = std::max(
+                { edge, std::abs(delta.x()), std::abs(delta.y()),
+                  std::abs(delta.z()) });
+        const auto normal = std::abs(triangle.er) + std::abs(triangle.ec) +
+                            std::abs(triangle.ez);
+        const auto margin = static_cast<Scalar>(
+            Hull::Predicates::unitRoundoff<Scalar> * scale *
+            (16.0 * normal + 96.0 * static_cast<double>(edge) * edge));
+        margins.emplace_back(margin);
+        planes.push_back(
+            triangle.er, triangle.ec, triangle.ez,
+            facet_offset(pts, triangle) - margin);
     }
-    return hull;
 }
 
 // Visible edge facet, create 2 new hull plates.
+template <typename Scalar, typename Index>
 void test_external_edge(
-    const std::vector<vec3>& pts, std::vector<Hull::Triangle>& hull,
-    const int& pointID, const int& hullID, const int& triA, const int& triB,
-    const int& triC, const Hull::Triangle& hullK, int& hullXY, int& triXY) {
+    const std::vector<Hull::Point<Scalar>>& pts,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const Index& pointID, const Index& hullID, const Index& triA,
+    const Index& triB, const Index& triC,
+    const Hull::BasicTriangle<Scalar, Index>& hullK, Index& hullXY,
+    Index& triXY) {
+    using Triangle = Hull::BasicTriangle<Scalar, Index>;
     const auto& [sign, er, ec, ez] = cross_test(pts, triA, triB, triC, pointID);
-    if (sign < 0.0F) {
-        Hull::Triangle upTriangle{ static_cast<int>(hull.size()),
-                                   2,
-                                   pointID,
-                                   triA,
-                                   triB,
-                                   -1,
-                                   -1,
-                                   -1,
-                                   er,
-                                   ec,
-                                   ez };
-        Hull::Triangle downTriangle{ static_cast<int>(hull.size() + 1ULL),
-                                     2,
-                                     pointID,
-                                     triA,
-                                     triB,
-                                     -1,
-                                     -1,
-                                     -1,
-                                     -er,
-                                     -ec,
-                                     -ez };
-        if (hullK.er * er + hullK.ec * ec + hullK.ez * ez > 0) {
+    if (sign < Scalar(0)) {
+        Triangle upTriangle{ static_cast<Index>(hull.size()),
+                             2,
+                             pointID,
+                             triA,
+                             triB,
+                             -1,
+                             -1,
+                             -1,
+                             er,
+                             ec,
+                             ez };
+        Triangle downTriangle{ static_cast<Index>(hull.size() + 1ULL),
+                               2,
+                               pointID,
+                               triA,
+                               triB,
+                               -1,
+                               -1,
+                               -1,
+                               -er,
+                               -ec,
+                               -ez };
+        if (hullK.er * er + hullK.ec * ec + hullK.ez * ez > Scalar(0)) {
             upTriangle.bc = hullID;
             downTriangle.bc = triXY;
             triXY = upTriangle.id;
@@ -298,21 +1407,25 @@ void test_external_edge(
     }
 };
 
+template <typename Scalar, typename Index>
 bool check_direction(
-    const int& idA, const int& idB,
-    const std::vector<Hull::Triangle>& hull) noexcept {
+    const Index& idA, const Index& idB,
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull) noexcept {
     return (hull[idA].er * hull[idB].er) + (hull[idA].ec * hull[idB].ec) +
                (hull[idA].ez * hull[idB].ez) >
-           0.0F;
+           Scalar(0);
 }
 
-// Add a point coplanar to the existing planar hull in 3D
+// Add a point coplanar to the existing planar hull in 3D, using 'edgeMap' as
+// scratch space for pairing up the edges of the new facets.
+template <typename Scalar, typename Index>
 void add_coplanar(
-    const std::vector<vec3>& pts, std::vector<Hull::Triangle>& hull,
-    const int& pointID) {
+    const std::vector<Hull::Point<Scalar>>& pts,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    Hull::BasicEdgeMap<Index>& edgeMap, const Index& pointID) {
     // Find visible edges. from external edges.
-    const auto numh = static_cast<int>(hull.size());
-    for (int hullID = 0; hullID < numh; ++hullID) {
+    const auto numh = static_cast<Index>(hull.size());
+    for (Index hullID = 0; hullID < numh; ++hullID) {
         // Test AB for visibility from new point
         if (hull[hullID].c == hull[hull[hullID].ab].c)
             test_external_edge(
@@ -333,100 +1446,162 @@ void add_coplanar(
                 hull[hullID].ac);
     }
 
-    // Fix up the non assigned hull adjacencies (correctly).
-    std::vector<Hull::Snork> norts;
-    norts.reserve(hull.size() + 1ULL);
-    for (int hullID = static_cast<int>(hull.size() - 1ULL); hullID >= numh;
-         --hullID) {
+    // Fix up the non assigned hull adjacencies (correctly). The flat hull
+    // has a facet on either side, and new facets pair with those facing the
+    // same way, except at the two ends of the new region, where the edge
+    // wraps around from one side to the other.
+    const auto newest = static_cast<Index>(hull.size() - 1ULL);
+    edgeMap.reset((hull.size() - static_cast<size_t>(numh)) * 2ULL);
+    for (auto hullID = newest; hullID >= numh; --hullID) {
         if (hull[hullID].keep > 1) {
-            norts.emplace_back(Hull::Snork{ hullID, hull[hullID].b, 1 });
-            norts.emplace_back(Hull::Snork{ hullID, hull[hullID].c, 0 });
+            const auto facing = check_direction(hullID, newest, hull);
+            stitch_edge(hull, edgeMap, hullID, hull[hullID].b, facing);
+            stitch_edge(hull, edgeMap, hullID, hull[hullID].c, facing);
             hull[hullID].keep = 1;
         }
     }
-    if (norts.size() < 2)
-        return;
-
-    std::sort(norts.begin(), norts.end());
-    const auto startSize = static_cast<int>(norts.size());
-    norts.emplace_back(Hull::Snork{ -1, -1, -1 });
-    norts.emplace_back(Hull::Snork{ -2, -2, -2 });
-
-    for (int nortID = 0; nortID < startSize - 1; ++nortID) {
-        if (norts[nortID].a != norts[nortID + 1ULL].a)
-            continue;
-
-        // Link triangle sides.
-        if (norts[nortID].a != norts[nortID + 2ULL].a) {
-            // edge of figure case
-            if (norts[nortID].b == 1)
-                hull[norts[nortID].id].ab = norts[nortID + 1ULL].id;
-            else
-                hull[norts[nortID].id].ac = norts[nortID + 1ULL].id;
-            if (norts[nortID + 1ULL].b == 1)
-                hull[norts[nortID + 1ULL].id].ab = norts[nortID].id;
-            else
-                hull[norts[nortID + 1ULL].id].ac = norts[nortID].id;
-            nortID++;
+    for (auto& edge : edgeMap.edges) {
+        if (edge.facet == -1)
             continue;
-        }
-        // Internal figure boundary 4 junction case.
-        auto& snork0 = norts[nortID];
-        auto& snork1 = norts[nortID + 1ULL];
-        auto& snork2 = norts[nortID + 2ULL];
-        auto& snork3 = norts[nortID + 3ULL];
-
-        // Check normal directions of id and id1..3
-        if (check_direction(snork0.id, snork1.id, hull)) {
-            if (check_direction(snork0.id, snork2.id, hull))
-                std::swap(snork1.id, snork2.id);
-            else if (check_direction(snork0.id, snork2.id, hull))
-                std::swap(snork1.id, snork3.id);
-        }
-
-        if (norts[nortID].b == 1)
-            hull[snork0.id].ab = snork1.id;
-        else
-            hull[snork0.id].ac = snork1.id;
-
-        if (snork1.b == 1)
-            hull[snork1.id].ab = snork0.id;
-        else
-            hull[snork1.id].ac = snork0.id;
-
-        // Use s2 and s3
-        if (snork2.b == 1)
-            hull[snork2.id].ab = snork3.id;
-        else
-            hull[snork2.id].ac = snork3.id;
+        const auto facet = edge.facet;
+        edge.facet = -1;
+        stitch_edge(hull, edgeMap, facet, edge.vertex, !edge.facing);
+    }
+}
 
-        if (snork3.b == 1)
-            hull[snork3.id].ab = snork2.id;
-        else
-            hull[snork3.id].ac = snork2.id;
-        nortID += 3;
+// Link a new facet to the one across its edge to 'vertex', which it shares
+// with the new point, or leave it in the map until that facet turns up.
+template <typename Scalar, typename Index>
+void stitch_edge(
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    Hull::BasicEdgeMap<Index>& edgeMap, const Index& facet,
+    const Index& vertex, const bool& facing) noexcept {
+    auto& edge = edgeMap.find(vertex, facing);
+    if (edge.facet == -1) {
+        edge = { vertex, facet, facing };
+        return;
     }
+    const auto other = edge.facet;
+    edge.facet = -1;
+    (hull[facet].b == vertex ? hull[facet].ab : hull[facet].ac) = other;
+    (hull[other].b == vertex ? hull[other].ab : hull[other].ac) = facet;
 }
 
 // Cross product relative sign test.
-std::tuple<float, float, float, float> cross_test(
-    const std::vector<vec3>& pts, const int& triA, const int& triB,
-    const int& triC, const int& pointID) noexcept {
+template <typename Scalar, typename Index>
+std::tuple<Scalar, Scalar, Scalar, Scalar> cross_test(
+    const std::vector<Hull::Point<Scalar>>& pts, const Index& triA,
+    const Index& triB, const Index& triC, const Index& pointID) noexcept {
     const auto& pointA(pts[triA]);
     const auto& pointB(pts[triB]);
     const auto& pointC(pts[triC]);
     const auto& pointX(pts[pointID]);
 
-    const auto test1 = pointB - pointA;
-    const auto test2 = pointC - pointA;
-    const auto test3 = pointX - pointA;
-
-    const auto cross1 = test1.cross(test2);
-    const auto cross2 = test1.cross(test3);
+    const auto cross2 = facet_normal(pointA, pointB, pointX);
 
-    // Look at sign of (ab x ac).(ab x ax)
-    const auto globit = (cross1.x() * cross2.x()) + (cross1.y() * cross2.y()) +
-                        (cross1.z() * cross2.z());
+    // Look at sign of (ab x ac).(ab x ax). The points are coplanar, so it
+    // is exactly the product of their turns seen along the axis the plane
+    // faces the most. The turns along each axis are the components of
+    // ab x ac, so pick that axis from them rather than from a rounded
+    // cross product, which can vanish for thin triangles.
+    auto axis(0);
+    auto turnC(0.0);
+    for (int candidate = 0; candidate < 3; ++candidate) {
+        const auto turn =
+            Hull::Predicates::orient2d(pointA, pointB, pointC, candidate);
+        if (std::abs(turn) > std::abs(turnC)) {
+            axis = candidate;
+            turnC = turn;
+        }
+    }
+    const auto turnX = Hull::Predicates::orient2d(pointA, pointB, pointX, axis);
+    const auto globit = static_cast<Scalar>(
+        ((turnC > 0.0) - (turnC < 0.0)) * ((turnX > 0.0) - (turnX < 0.0)));
 
     return { globit, cross2.x(), cross2.y(), cross2.z() };
-}
\ No newline at end of file
+}
+
+// Explicit Instantiations
+template std::vector<Hull::Point<float>> Hull::generate_convex_hull(
+    const std::vector<Point<float>>& points, const Options& options,
+    Stats* stats);
+template std::vector<Hull::Point<double>> Hull::generate_convex_hull(
+    const std::vector<Point<double>>& points, const Options& options,
+    Stats* stats);
+template std::vector<Hull::Point<float>> Hull::generate_convex_hull(
+    const BasicPointSpan<float>& points, const Options& options, Stats* stats);
+template std::vector<Hull::Point<double>> Hull::generate_convex_hull(
+    const BasicPointSpan<double>& points, const Options& options,
+    Stats* stats);
+template size_t Hull::generate_convex_hull(
+    const BasicPointSpan<float>& points, const BasicFaceSink<float>& sink,
+    const Options& options, Stats* stats);
+template size_t Hull::generate_convex_hull(
+    const BasicPointSpan<double>& points, const BasicFaceSink<double>& sink,
+    const Options& options, Stats* stats);
+template float
+coordinate_scale(const std::vector<Hull::Point<float>>& pts) noexcept;
+template double
+coordinate_scale(const std::vector<Hull::Point<double>>& pts) noexcept;
+template Hull::Point<float> facet_normal(
+    const Hull::Point<float>& a, const Hull::Point<float>& b,
+    const Hull::Point<float>& c) noexcept;
+template Hull::Point<double> facet_normal(
+    const Hull::Point<double>& a, const Hull::Point<double>& b,
+    const Hull::Point<double>& c) noexcept;
+#define INSTANTIATE_HULL(Scalar, Index)                                        \
+    template std::vector<Hull::Point<Scalar>> Hull::generate_convex_hull(      \
+        const BasicPointSpan<Scalar>& points,                                  \
+        BasicWorkspace<Scalar, Index>& workspace, const Options& options,      \
+        Stats* stats);                                                         \
+    template size_t Hull::generate_convex_hull(                                \
+        const BasicPointSpan<Scalar>& points,                                  \
+        BasicWorkspace<Scalar, Index>& workspace,                              \
+        const BasicFaceSink<Scalar>& sink, const Options& options,             \
+        Stats* stats);                                                         \
+    template Hull::BasicMesh<Index> Hull::generate_convex_mesh<Index, Scalar>( \
+        const std::vector<Point<Scalar>>& points, const Options& options,      \
+        Stats* stats);                                                         \
+    template Hull::BasicMesh<Index> Hull::generate_convex_mesh<Index, Scalar>( \
+        const BasicPointSpan<Scalar>& points, const Options& options,          \
+        Stats* stats);                                                         \
+    template Hull::BasicMesh<Index> Hull::generate_convex_mesh<Index, Scalar>( \
+        const BasicPointSpan<Scalar>& points,                                  \
+        BasicWorkspace<Scalar, Index>& workspace, const Options& options,      \
+        Stats* stats);                                                         \
+    template Hull::BasicMesh<Index> Hull::generate_convex_mesh<Index, Scalar>( \
+        const BasicPointSpan<Scalar>& points, const std::vector<Index>& seeds, \
+        BasicWorkspace<Scalar, Index>& workspace, Stats* stats);               \
+    template void add_point(                                                   \
+        const std::vector<Hull::Point<Scalar>>& pts,                           \
+        std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,                 \
+        std::vector<Index>& freeSlots, std::vector<Index>& xList,              \
+        std::vector<Index>& newList,                                           \
+        Hull::BasicEdgeMap<Index>& edgeMap, const Index& pointID,              \
+        const Index& hvis);                                                    \
+    template bool is_visible(                                                  \
+        const std::vector<Hull::Point<Scalar>>& pts,                           \
+        const Hull::BasicTriangle<Scalar, Index>& triangle,                    \
+        const Hull::Point<Scalar>& point) noexcept;                            \
+    template bool renumber_hull(                                               \
+        std::vector<Hull::BasicTriangle<Scalar, Index>>& hull);                \
+    template Hull::BasicMesh<Index> build_mesh(                                \
+        const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,           \
+        const std::vector<Hull::Point<Scalar>>& points,                        \
+        const std::vector<Index>& order);                                      \
+    template void gather_planes(                                               \
+        const std::vector<Hull::Point<Scalar>>& pts,                           \
+        const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,           \
+        const std::vector<Index>& facets, const Scalar& scale,                 \
+        Hull::Simd::BasicPlanes<Scalar>& planes, std::vector<Scalar>& margins);\
+    template Index find_visible(                                               \
+        const std::vector<Hull::Point<Scalar>>& pts,                           \
+        const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,           \
+        const std::vector<Index>& facets,                                      \
+        const Hull::Simd::BasicPlanes<Scalar>& planes,                         \
+        const std::vector<Scalar>& margins, const Hull::Point<Scalar>& point);
+INSTANTIATE_HULL(float, std::int32_t);
+INSTANTIATE_HULL(float, std::int64_t);
+INSTANTIATE_HULL(double, std::int32_t);
+INSTANTIATE_HULL(double, std::int64_t);
+#undef INSTANTIATE_HULL
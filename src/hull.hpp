@@ -3,6 +3,10 @@
 
 #include "Utility/mat.hpp"
 #include "Utility/vec.hpp"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 //////////////////////////////////////////////////////////////////////
@@ -11,20 +15,35 @@ using namespace mini;
 
 /** Namespace encapsulating all hull-related operations. */
 namespace Hull {
+/** A point whose coordinates use the given scalar type. */
+template <typename Scalar> using Point = vec<Scalar, 3>;
+
+/** The most points a hull can be built from with a given index type, as the
+facet pool may need up to 4 facet slots per point. */
+template <typename Index>
+constexpr size_t maxPoints =
+    static_cast<size_t>(std::numeric_limits<Index>::max()) / 4ULL;
+
+/** The narrowest index type able to build a hull from 'MaxPoints' points,
+keeping the compact 32-bit facet layout whenever it fits. */
+template <size_t MaxPoints>
+using IndexFor = std::conditional_t<
+    (MaxPoints <= maxPoints<std::int32_t>), std::int32_t, std::int64_t>;
+
 /** A triangle referencing specific point indexes. */
-struct Triangle {
+template <typename Scalar, typename Index> struct BasicTriangle {
     // Attributes
-    int id = 0, keep = 1;
-    int a = 0, b = 0, c = 0;
-    int ab = -1, bc = -1,
-        ac = -1; // adjacent edges index to neighbouring triangle.
-    float er = 0.0f, ec = 0.0f,
-          ez = 0.0f; // visible normal to triangular facet.
+    Index id = 0, keep = 1;
+    Index a = 0, b = 0, c = 0;
+    Index ab = -1, bc = -1,
+          ac = -1; // adjacent edges index to neighbouring triangle.
+    Scalar er = Scalar(0), ec = Scalar(0),
+           ez = Scalar(0); // visible normal to triangular facet.
 
     // Operators
     /** Compare whether or not this triangle equals another.
     @param  t   the other triangle to compare against. */
-    bool operator==(const Triangle& t) const noexcept {
+    bool operator==(const BasicTriangle& t) const noexcept {
         return (
             (a == t.a || a == t.b || a == t.c) &&
             (b == t.a || b == t.b || b == t.c) &&
@@ -35,13 +54,13 @@ struct Triangle {
     /** Check if this triangle faces the same direction as another.
     @param  other   the other triangle to compare against.
     @return true if this triangle faces the same direction, false otherwise. */
-    bool FaceSameDirection(const Triangle& other) const noexcept {
+    bool FaceSameDirection(const BasicTriangle& other) const noexcept {
         return (er == other.er && ec == other.ec && ez == other.ez);
     }
     /** Checks if this triangle is adjacent to another.
     @param  other   the other triangle to compare against.
     @return true if this triangle is adjacent to another, false otherwise. */
-    bool AreAdjacent(const Triangle& other) const noexcept {
+    bool AreAdjacent(const BasicTriangle& other) const noexcept {
         return (
             a == other.ab || a == other.bc || a == other.ac || b == other.ab ||
             b == other.bc || b == other.ac || c == other.ab || c == other.bc ||
@@ -49,20 +68,191 @@ struct Triangle {
     }
     /** Compute the normal for this triangle.
     @return the normal vector for this triangle. */
-    vec3 normal() const noexcept { return vec3(er, ec, ez); }
+    Point<Scalar> normal() const noexcept {
+        return Point<Scalar>(er, ec, ez);
+    }
+};
+/** The triangle used by the default float hull. */
+using Triangle = BasicTriangle<float, int>;
+
+/** Pairs up the edges that new facets share with each other when a point is
+added to the hull. Every new facet has 2 edges running to the new point, each
+keyed here on its other vertex and on which way the facet faces, in a small
+open-addressing table kept at most half full. */
+template <typename Index> struct BasicEdgeMap {
+    /** An edge waiting for the facet across it. */
+    struct Edge {
+        Index vertex = -1;   // the vertex it leads to, -1 if the slot is free.
+        Index facet = -1;    // the facet waiting on it, -1 once paired up.
+        bool facing = false; // which way the facet faces.
+    };
+
+    // Attributes
+    std::vector<Edge> edges;
+    unsigned int shift = 64U;
+
+    // Methods
+    /** Empty the map, making room for a number of edges.
+    @param  count   the most edges that will be added. */
+    void reset(const size_t& count) {
+        size_t size(16ULL);
+        shift = 60U;
+        while (size < count * 2ULL) {
+            size <<= 1U;
+            --shift;
+        }
+        edges.assign(size, Edge{});
+    }
+    /** Find the slot holding an edge, or the free slot it belongs in.
+    @param  vertex  the vertex the edge leads to.
+    @param  facing  which way the facet on it faces.
+    @return the slot of the edge. */
+    Edge& find(const Index& vertex, const bool& facing) noexcept {
+        const auto key = static_cast<std::uint64_t>(vertex) * 2ULL +
+                         static_cast<std::uint64_t>(facing);
+        const auto mask = edges.size() - 1ULL;
+        auto slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift);
+        while (edges[slot].vertex != -1 &&
+               (edges[slot].vertex != vertex || edges[slot].facing != facing))
+            slot = (slot + 1ULL) & mask;
+        return edges[slot];
+    }
+};
+/** The edge map used by the default float hull. */
+using EdgeMap = BasicEdgeMap<int>;
+
+/** Engines that can build a convex hull. */
+enum class Algorithm {
+    Incremental, // inserts points in turn, patching up coplanar points.
+    QuickHull    // adds the farthest point above a facet each step.
+};
+
+/** Orders the points can be inserted into a hull in. Both curve orders come
+from a radix sort, which is cheaper than sorting lexicographically and keeps
+consecutive insertions close together in space. Without any randomness the
+Morton order can re-file far more points, so it suits QuickHull better than
+the incremental engine. */
+enum class InsertionOrder {
+    Sorted, // lexicographic, shuffled once the hull has volume.
+    Morton, // along a Z-order curve over the points' bounding box.
+    Biased  // random rounds of doubling size, each along the Z-order curve.
+};
+
+/** Settings controlling how a convex hull gets generated. */
+struct Options {
+    // Attributes
+    Algorithm algorithm = Algorithm::Incremental; // the engine to use.
+    bool prefilter = false; // cull interior points before sorting them.
+    size_t threads = 0ULL;  // threads for the slab engine, 0 to not use it.
+    InsertionOrder order = InsertionOrder::Sorted; // point insertion order.
+};
+
+/** Settings controlling how an approximate convex hull gets generated. The
+hull is refined until it meets either limit. */
+struct ApproximateOptions {
+    // Attributes
+    size_t maxFaces = 256ULL;  // most faces of the hull, 4 or more, 0 for any.
+    double epsilon = 0.0;      // how far points may lie outside of the hull.
+    bool conservative = false; // grow the hull until it holds every point.
+};
+
+/** Measurements recorded while generating a convex hull. Phase timings are
+wall-clock nanoseconds, those of the engine phases summed over every slab
+when the slab engine runs. Timings and counters stay zero in builds with
+HULL_STATS defined as 0. */
+struct Stats {
+    // Attributes
+    size_t peakFacets = 0ULL;   // most facet slots held by the pool at once.
+    size_t peakBytes = 0ULL;    // most bytes held by the hull buffers at once.
+    size_t culledPoints = 0ULL; // points removed by the pre-filter.
+    std::uint64_t prefilterNs = 0ULL; // culling interior points.
+    std::uint64_t sortNs = 0ULL;      // ordering points, or the slab engine.
+    std::uint64_t flatNs = 0ULL;      // seeding a hull until it has volume.
+    std::uint64_t fileNs = 0ULL;      // filing points under the first facets.
+    std::uint64_t insertNs = 0ULL;    // inserting points and re-filing them.
+    std::uint64_t renumberNs = 0ULL;  // compacting the facets of a mesh.
+    std::uint64_t outputNs = 0ULL;    // winding and copying out the faces.
+    size_t pointsInserted = 0ULL;  // points added once the hull had volume.
+    size_t pointsInterior = 0ULL;  // points found inside and discarded.
+    size_t visibilityTests = 0ULL; // points located against a set of facets.
+    size_t coplanarPoints = 0ULL;  // points added while the hull was flat.
+    size_t facetsCreated = 0ULL;   // facets made, seed facets included.
+    size_t facetsRetired = 0ULL;   // facets seen by an inserted point.
+    size_t horizonEdges = 0ULL;    // horizon edges summed over insertions.
+    size_t maxHorizon = 0ULL;      // most horizon edges of one insertion.
+};
+
+/** An indexed convex hull referencing the points it was generated from. */
+template <typename Index> struct BasicMesh {
+    // Attributes
+    std::vector<Index> vertices;  // input point index of each hull vertex.
+    std::vector<Index> indices;   // 3 vertex ids per face, counter-clockwise.
+    std::vector<Index> adjacency; // 3 face ids per face, across each edge.
 };
+/** The indexed convex hull with the compact 32-bit index. */
+using Mesh = BasicMesh<int>;
 
-struct Snork {
+/** A read-only view of points owned by the caller. Points sit 'stride' bytes
+apart, so they may be the positions inside larger interleaved records, as
+long as every point stays aligned. */
+template <typename Scalar> struct BasicPointSpan {
     // Attributes
-    int id = -1;
-    int a = 0, b = 0;
+    const Point<Scalar>* data = nullptr;   // the first point.
+    size_t count = 0ULL;                   // the number of points.
+    size_t stride = sizeof(Point<Scalar>); // bytes from a point to the next.
 
     // Operators
-    bool operator<(const Snork& other) const noexcept {
-        if (a == other.a)
-            return b < other.b;
-        return a < other.a;
-    };
+    /** Retrieve a point from this view.
+    @param  index   the index of the point to retrieve.
+    @return the point at the given index. */
+    const Point<Scalar>& operator[](const size_t& index) const noexcept {
+        return *reinterpret_cast<const Point<Scalar>*>(
+            reinterpret_cast<const unsigned char*>(data) + index * stride);
+    }
+};
+/** The read-only view of float points. */
+using PointSpan = BasicPointSpan<float>;
+
+/** Buffers a hull gets built in, kept between calls, see workspace.hpp. */
+template <typename Scalar, typename Index> struct BasicWorkspace;
+
+/** Receives the faces of a convex hull one at a time, as their 3 points
+wound counter-clockwise when seen from outside the hull. Declared through a
+struct so that the point type never gets deduced from a sink. */
+template <typename Scalar> struct FaceSinkOf {
+    using type = std::function<void(
+        const Point<Scalar>&, const Point<Scalar>&, const Point<Scalar>&)>;
+};
+/** A face sink for points with the given scalar type. */
+template <typename Scalar>
+using BasicFaceSink = typename FaceSinkOf<Scalar>::type;
+/** The face sink for float points. */
+using FaceSink = BasicFaceSink<float>;
+
+/** Many convex hulls stored back to back in one triangle soup. */
+struct HullBatch {
+    // Attributes
+    std::vector<vec3> vertices;  // 3 vertices per triangle, hull by hull.
+    std::vector<size_t> offsets; // hull i spans [offsets[i], offsets[i+1]).
+};
+
+/** Shapes a generated point cloud can take, all centered on the origin. */
+enum class Distribution {
+    Cube,     // uniform within the cube spanning [-scale, scale].
+    Ball,     // uniform within the ball of radius scale.
+    Sphere,   // uniform on the sphere of radius scale, all on the hull.
+    Gaussian, // normally distributed with a deviation of scale.
+    Clustered // normal clumps around centers spread over the cube.
+};
+
+/** Settings a point cloud is generated with. */
+struct CloudOptions {
+    // Attributes
+    Distribution distribution = Distribution::Cube; // the shape to fill.
+    float scale = 1.0F;      // the size of the shape.
+    size_t clusters = 64ULL; // the number of clumps of a clustered cloud.
+    float spread = 0.02F;    // the deviation of a clump, relative to scale.
+    size_t threads = 0ULL;   // threads to generate with, 0 for just this one.
 };
 
 /** Generate a point cloud with a specific number of points and scale.
@@ -72,9 +262,186 @@ struct Snork {
 @return a vector of points. */
 std::vector<vec3> generate_point_cloud(
     const float& scale, const size_t& count, const unsigned int& seed);
+/** Generate a point cloud in parallel from a counter-based generator. Each
+point is drawn from its own index, so the cloud is the same for a given seed
+at any thread count, and a smaller cloud is a prefix of a larger one.
+@param  count   the number of points to make.
+@param  seed    specific seed to use for random generation.
+@param  options the shape and settings to generate the cloud with.
+@return a vector of points. */
+std::vector<vec3> generate_point_cloud(
+    const size_t& count, const std::uint64_t& seed,
+    const CloudOptions& options = {});
 /** Generate a convex hull given a set of points.
+Instantiated for float and double points, the facets are indexed with 32
+bits unless there are too many points for them.
 @param  points  the points to generate a hull from.
+@param  options the settings to generate the hull with.
+@param  stats   optional output for measurements taken during generation.
+@return a convex hull containing the input points. */
+template <typename Scalar>
+std::vector<Point<Scalar>> generate_convex_hull(
+    const std::vector<Point<Scalar>>& points, const Options& options = {},
+    Stats* stats = nullptr);
+/** Generate a convex hull over points owned by the caller, such as the
+positions inside larger records of a mapped file. Only an index per point is
+sorted, and only the points that reach the engine get copied.
+@param  points  the view of the points to generate a hull from.
+@param  options the settings to generate the hull with.
+@param  stats   optional output for measurements taken during generation.
 @return a convex hull containing the input points. */
-std::vector<vec3> generate_convex_hull(const std::vector<vec3>& points);
+template <typename Scalar>
+std::vector<Point<Scalar>> generate_convex_hull(
+    const BasicPointSpan<Scalar>& points, const Options& options = {},
+    Stats* stats = nullptr);
+/** Generate a convex hull in a workspace kept by the caller, so that
+repeated hulls reuse its buffers rather than allocating their own.
+@param  points      the view of the points to generate a hull from.
+@param  workspace   the buffers to build the hull in, overwritten.
+@param  options     the settings to generate the hull with.
+@param  stats       optional output for measurements taken during
+                    generation.
+@return a convex hull containing the input points, empty if there are more
+        than maxPoints<Index> of them. */
+template <typename Scalar, typename Index>
+std::vector<Point<Scalar>> generate_convex_hull(
+    const BasicPointSpan<Scalar>& points,
+    BasicWorkspace<Scalar, Index>& workspace, const Options& options = {},
+    Stats* stats = nullptr);
+/** Generate a convex hull, handing each face to a sink as soon as the build
+is done rather than gathering a triangle soup, so that faces can go straight
+into a GPU buffer or a file. Faces are wound by the outward normal each facet
+was built with, and arrive in facet pool order.
+@param  points  the view of the points to generate a hull from.
+@param  sink    the callback receiving each face.
+@param  options the settings to generate the hull with.
+@param  stats   optional output for measurements taken during generation.
+@return the number of faces delivered, 0 if no hull could be built. */
+template <typename Scalar>
+size_t generate_convex_hull(
+    const BasicPointSpan<Scalar>& points, const BasicFaceSink<Scalar>& sink,
+    const Options& options = {}, Stats* stats = nullptr);
+/** Generate a convex hull in a workspace kept by the caller, handing each
+face to a sink as for the overload above.
+@param  points      the view of the points to generate a hull from.
+@param  workspace   the buffers to build the hull in, overwritten.
+@param  sink        the callback receiving each face.
+@param  options     the settings to generate the hull with.
+@param  stats       optional output for measurements taken during
+                    generation.
+@return the number of faces delivered, 0 if no hull could be built. */
+template <typename Scalar, typename Index>
+size_t generate_convex_hull(
+    const BasicPointSpan<Scalar>& points,
+    BasicWorkspace<Scalar, Index>& workspace,
+    const BasicFaceSink<Scalar>& sink, const Options& options = {},
+    Stats* stats = nullptr);
+/** Generate a convex hull of at most a budget of faces, approximating the
+hull of many points in a few passes over them rather than a full build. The
+extreme points along the directions of a 26-DOP get hulled, then each round
+drops the points inside and adds the point lying farthest outside each face,
+until every point is within 'epsilon' of the hull or the face budget is
+spent. By default its vertices are input points, so the hull lies inside
+the exact hull, and 'error' bounds the Hausdorff distance between the two. A
+conservative hull instead grows about its center until every face plane has
+moved out by that bound, so that it holds every point. Flat points get a
+flat hull within the same budget, refined by the edges around it rather
+than its faces.
+Instantiated for float and double points.
+@param  points  the points to approximate the hull of.
+@param  options the face budget and tolerance to approximate the hull with.
+@param  error   optional output for the farthest any point may lie outside
+                of the hull, up to rounding, 0 if none does. For conservative
+                hulls, it is the farthest the hull may reach past the exact
+                hull instead.
+@return an approximate convex hull, empty if there are fewer than 4
+        points or they all lie on a line. */
+template <typename Scalar>
+std::vector<Point<Scalar>> approximate_convex_hull(
+    const std::vector<Point<Scalar>>& points,
+    const ApproximateOptions& options = {}, Scalar* error = nullptr);
+/** Generate a convex hull of at most a budget of faces, over points owned
+by the caller.
+@param  points  the view of the points to approximate the hull of.
+@param  options the face budget and tolerance to approximate the hull with.
+@param  error   optional output for the farthest any point may lie outside
+                of the hull, up to rounding, 0 if none does. For conservative
+                hulls, it is the farthest the hull may reach past the exact
+                hull instead.
+@return an approximate convex hull, empty if there are fewer than 4
+        points or they all lie on a line. */
+template <typename Scalar>
+std::vector<Point<Scalar>> approximate_convex_hull(
+    const BasicPointSpan<Scalar>& points,
+    const ApproximateOptions& options = {}, Scalar* error = nullptr);
+/** Generate convex hulls for many sets of points at once, spreading them
+across a work-stealing thread pool.
+@param  clouds  the sets of points to generate hulls from.
+@param  options the settings to generate the hulls with, 'threads' sets
+                the pool size, or 0 to use every hardware thread.
+@return every convex hull, in the order the point sets were given. */
+HullBatch generate_convex_hulls(
+    const std::vector<PointSpan>& clouds, const Options& options = {});
+/** Generate an indexed convex hull given a set of points.
+Face 'f' uses vertex ids indices[3f..3f+2], wound counter-clockwise when
+seen from outside the hull, and adjacency[3f + i] holds the face sharing
+the edge from its i'th to its next vertex.
+Instantiated for float and double points, with 32 or 64-bit indices.
+@tparam Index   the index type of the facets and of the mesh, see IndexFor.
+@param  points  the points to generate a hull from.
+@param  options the settings to generate the hull with.
+@param  stats   optional output for measurements taken during generation.
+@return an indexed convex hull containing the input points, empty if there
+        are more than maxPoints<Index> of them. */
+template <typename Index = int, typename Scalar>
+BasicMesh<Index> generate_convex_mesh(
+    const std::vector<Point<Scalar>>& points, const Options& options = {},
+    Stats* stats = nullptr);
+/** Generate an indexed convex hull over points owned by the caller, laid out
+as for generate_convex_hull.
+@tparam Index   the index type of the facets and of the mesh, see IndexFor.
+@param  points  the view of the points to generate a hull from.
+@param  options the settings to generate the hull with.
+@param  stats   optional output for measurements taken during generation.
+@return an indexed convex hull whose vertex ids index the view, empty if
+        there are more than maxPoints<Index> points. */
+template <typename Index = int, typename Scalar>
+BasicMesh<Index> generate_convex_mesh(
+    const BasicPointSpan<Scalar>& points, const Options& options = {},
+    Stats* stats = nullptr);
+/** Generate an indexed convex hull in a workspace kept by the caller, so
+that repeated hulls reuse its buffers rather than allocating their own.
+@param  points      the view of the points to generate a hull from.
+@param  workspace   the buffers to build the hull in, overwritten.
+@param  options     the settings to generate the hull with.
+@param  stats       optional output for measurements taken during
+                    generation.
+@return an indexed convex hull whose vertex ids index the view, empty if
+        there are more than maxPoints<Index> points. */
+template <typename Index, typename Scalar>
+BasicMesh<Index> generate_convex_mesh(
+    const BasicPointSpan<Scalar>& points,
+    BasicWorkspace<Scalar, Index>& workspace, const Options& options = {},
+    Stats* stats = nullptr);
+/** Generate an indexed convex hull warm started from points expected to be
+on it, such as the vertices of the previous frame's hull of points that only
+moved a little. The seeds are inserted first, starting from the tetrahedron
+spanning the most of them, so their hull is in place before the other points
+are filed against it and most of those get discarded as interior without
+ever being inserted. Stale seeds only cost time, the hull stays exact. Warm
+starts always run the incremental engine on a single thread.
+@param  points      the view of the points to generate a hull from.
+@param  seeds       the indexes of points likely on the hull, duplicates and
+                    indexes out of range are skipped.
+@param  workspace   the buffers to build the hull in, overwritten.
+@param  stats       optional output for measurements taken during
+                    generation.
+@return an indexed convex hull whose vertex ids index the view and can seed
+        the next frame, empty if there are more than maxPoints<Index>
+        points. */
+template <typename Index, typename Scalar>
+BasicMesh<Index> generate_convex_mesh(
+    const BasicPointSpan<Scalar>& points, const std::vector<Index>& seeds,
+    BasicWorkspace<Scalar, Index>& workspace, Stats* stats = nullptr);
 };     // namespace Hull
 #endif // HULL_HPP
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "incrementalHull.hpp"
+#include "predicates.hpp"
+
+// Forward Declarations
+template <typename Scalar, typename Index>
+bool initial_simplex(
+    const std::vector<Hull::Point<Scalar>>& pts, const Index& count,
+    std::array<Index, 4>& simplex) noexcept;
+template <typename Scalar, typename Index>
+void simplex_hull(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::array<Index, 4>& simplex, const Hull::Point<Scalar>& middle,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull);
+template <typename Scalar, typename Index>
+void add_point(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    std::vector<Index>& freeSlots, std::vector<Index>& xList,
+    std::vector<Index>& newList, Hull::BasicEdgeMap<Index>& edgeMap,
+    const Index& pointID, const Index& hvis);
+template <typename Scalar, typename Index>
+bool is_visible(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::BasicTriangle<Scalar, Index>& triangle,
+    const Hull::Point<Scalar>& point) noexcept;
+template <typename Scalar, typename Index>
+bool renumber_hull(std::vector<Hull::BasicTriangle<Scalar, Index>>& hull);
+template <typename Scalar, typename Index>
+Hull::BasicMesh<Index> build_mesh(
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Hull::Point<Scalar>>& points,
+    const std::vector<Index>& order);
+
+//////////////////////////////////////////////////////////////////////
+/// insert
+//////////////////////////////////////////////////////////////////////
+
+template <typename Scalar, typename Index>
+bool Hull::BasicIncrementalHull<Scalar, Index>::insert(
+    const BasicPointSpan<Scalar>& points) {
+    // Refuse points the index type could not name, or the pool could not
+    // hold the facets of
+    if (points.count > maxPoints<Index> - m_points.size())
+        return false;
+
+    const auto first = static_cast<Index>(m_points.size());
+    m_points.reserve(m_points.size() + points.count);
+    for (size_t i = 0ULL; i < points.count; ++i)
+        m_points.emplace_back(points[i]);
+
+    // Hold on to the points until they span a volume
+    if (m_hull.empty()) {
+        start_hull(first);
+        return true;
+    }
+
+    const auto last = static_cast<Index>(m_points.size());
+    for (auto pointID = first; pointID < last; ++pointID)
+        add_to_hull(pointID);
+    return true;
+}
+
+template <typename Scalar, typename Index>
+bool Hull::BasicIncrementalHull<Scalar, Index>::insert(
+    const std::vector<Point<Scalar>>& points) {
+    return insert(BasicPointSpan<Scalar>{ points.data(), points.size() });
+}
+
+//////////////////////////////////////////////////////////////////////
+/// snapshot
+//////////////////////////////////////////////////////////////////////
+
+template <typename Scalar, typename Index>
+Hull::BasicMesh<Index>
+Hull::BasicIncrementalHull<Scalar, Index>::snapshot() const {
+    auto hull(m_hull);
+    if (!renumber_hull(hull))
+        return {};
+    return build_mesh(hull, m_points, std::vector<Index>{});
+}
+
+//////////////////////////////////////////////////////////////////////
+/// start_hull
+//////////////////////////////////////////////////////////////////////
+
+template <typename Scalar, typename Index>
+void Hull::BasicIncrementalHull<Scalar, Index>::start_hull(
+    const Index& first) {
+    // Only look at the new points for one leaving the point, line or plane
+    // the held points span, so a long flat start stays linear
+    const auto last = static_cast<Index>(m_points.size());
+    auto spansVolume(false);
+    Index leaving(0);
+    for (auto pointID = first; pointID < last && !spansVolume; ++pointID) {
+        const auto& point = m_points[pointID];
+        if (m_spanSize == 0ULL) {
+            m_span[m_spanSize++] = pointID;
+        } else if (m_spanSize == 1ULL) {
+            const auto delta = point - m_points[m_span[0]];
+            if (delta.dot(delta) > Scalar(0))
+                m_span[m_spanSize++] = pointID;
+        } else if (m_spanSize == 2ULL) {
+            const auto& origin = m_points[m_span[0]];
+            const auto cross =
+                (m_points[m_span[1]] - origin).cross(point - origin);
+            if (cross.dot(cross) > Scalar(0))
+                m_span[m_spanSize++] = pointID;
+        } else {
+            spansVolume = Hull::Predicates::orient3d(
+                              m_points[m_span[0]], m_points[m_span[1]],
+                              m_points[m_span[2]], point) != 0.0;
+            if (spansVolume)
+                leaving = pointID;
+        }
+    }
+    if (!spansVolume)
+        return;
+
+    // Prefer a tetrahedron spread across all the points, falling back to
+    // the span and the point that left it
+    std::array<Index, 4> simplex{};
+    if (!initial_simplex(m_points, last, simplex))
+        simplex = { m_span[0], m_span[1], m_span[2], leaving };
+
+    // The hull only ever grows, so the tetrahedron's centre stays inside it
+    m_middle = (m_points[simplex[0]] + m_points[simplex[1]] +
+                m_points[simplex[2]] + m_points[simplex[3]]) /
+               Vertex(Scalar(4));
+    simplex_hull(m_points, simplex, m_middle, m_hull);
+    m_lastFacet = 0;
+    for (Index pointID = 0; pointID < last; ++pointID)
+        if (pointID != simplex[0] && pointID != simplex[1] &&
+            pointID != simplex[2] && pointID != simplex[3])
+            add_to_hull(pointID);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// add_to_hull
+//////////////////////////////////////////////////////////////////////
+
+template <typename Scalar, typename Index>
+void Hull::BasicIncrementalHull<Scalar, Index>::add_to_hull(
+    const Index& pointID) {
+    const auto hvis = find_visible(m_points[pointID]);
+    if (hvis < 0)
+        return;
+
+    add_point(
+        m_points, m_hull, m_freeSlots, m_xList, m_newList, m_edgeMap, pointID,
+        hvis);
+    m_freeSlots.insert(m_freeSlots.end(), m_xList.cbegin(), m_xList.cend());
+    if (!m_newList.empty())
+        m_lastFacet = m_newList.front();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// find_visible
+//////////////////////////////////////////////////////////////////////
+
+template <typename Scalar, typename Index>
+Index Hull::BasicIncrementalHull<Scalar, Index>::find_visible(
+    const Point<Scalar>& point) const {
+    // Walk towards the facet crossed by the ray from the middle to the
+    // point. A point outside the hull can see that facet, and a point
+    // before it is inside. Each step crosses an edge whose plane through
+    // the middle separates the ray from the rest of the facet, found
+    // exactly, rotating which edge is tried first so the walk cannot
+    // circle forever.
+    auto hullID = m_lastFacet;
+    const auto maxSteps = m_hull.size();
+    std::array<bool, 3> onEdge{};
+    size_t step(0ULL);
+    for (; step < maxSteps; ++step) {
+        const auto& triangle = m_hull[hullID];
+        const std::array<std::array<Index, 4>, 3> edges{
+            { { triangle.a, triangle.b, triangle.c, triangle.ab },
+              { triangle.b, triangle.c, triangle.a, triangle.bc },
+              { triangle.a, triangle.c, triangle.b, triangle.ac } }
+        };
+
+        // The middle sees the facet's corners in the same order from
+        // every edge, reversed for the last one
+        const auto facetSide = Hull::Predicates::orient3d(
+            m_middle, m_points[triangle.a], m_points[triangle.b],
+            m_points[triangle.c]);
+        Index next(-1);
+        for (size_t e = 0ULL; e < 3ULL && next < 0; ++e) {
+            const auto edge = (e + step) % 3ULL;
+            const auto& [u, v, w, across] = edges[edge];
+            const auto raySide = Hull::Predicates::orient3d(
+                m_middle, m_points[u], m_points[v], point);
+            onEdge[edge] = raySide == 0.0;
+            if (!onEdge[edge] &&
+                (raySide < 0.0) != ((facetSide < 0.0) != (edge == 2ULL)))
+                next = across;
+        }
+        if (next < 0)
+            break;
+        hullID = next;
+    }
+
+    // The ray crosses the facet the walk ended on, or just as well the one
+    // beyond an edge it passes through, or any around a corner it passes
+    // through. Fall back to every facet if the walk stalled.
+    const auto& triangle = m_hull[hullID];
+    if (step < maxSteps) {
+        if (is_visible(m_points, triangle, point))
+            return hullID;
+        const std::array<Index, 3> neighbours{ triangle.ab, triangle.bc,
+                                               triangle.ac };
+        for (size_t edge = 0ULL; edge < 3ULL; ++edge)
+            if (onEdge[edge] &&
+                is_visible(m_points, m_hull[neighbours[edge]], point))
+                return neighbours[edge];
+        const std::array<std::array<size_t, 2>, 3> cornerEdges{
+            { { 0ULL, 2ULL }, { 0ULL, 1ULL }, { 1ULL, 2ULL } }
+        };
+        const std::array<Index, 3> corners{ triangle.a, triangle.b,
+                                            triangle.c };
+        for (size_t corner = 0ULL; corner < 3ULL; ++corner) {
+            if (!onEdge[cornerEdges[corner][0]] ||
+                !onEdge[cornerEdges[corner][1]])
+                continue;
+            const auto candidate =
+                find_visible_around(point, corners[corner], hullID);
+            if (candidate >= 0)
+                return candidate;
+        }
+        return -1;
+    }
+    const auto hullSize = static_cast<Index>(m_hull.size());
+    for (Index candidate = 0; candidate < hullSize; ++candidate)
+        if (m_hull[candidate].keep > 0 &&
+            is_visible(m_points, m_hull[candidate], point))
+            return candidate;
+    return -1;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// find_visible_around
+//////////////////////////////////////////////////////////////////////
+
+template <typename Scalar, typename Index>
+Index Hull::BasicIncrementalHull<Scalar, Index>::find_visible_around(
+    const Point<Scalar>& point, const Index& vertex, const Index& start) const {
+    // Cross whichever of the two edges meeting at the vertex doesn't lead
+    // back, until arriving back at the start
+    auto previous(start);
+    auto hullID(start);
+    for (size_t step = 0ULL; step < m_hull.size(); ++step) {
+        const auto& triangle = m_hull[hullID];
+        const auto first = triangle.c == vertex ? triangle.bc : triangle.ab;
+        const auto second = triangle.b == vertex ? triangle.bc : triangle.ac;
+        const auto next = first != previous ? first : second;
+        previous = hullID;
+        hullID = next;
+        if (hullID == start || hullID < 0)
+            return -1;
+        if (is_visible(m_points, m_hull[hullID], point))
+            return hullID;
+    }
+    return -1;
+}
+
+// Explicit Instantiations
+template class Hull::BasicIncrementalHull<float, std::int32_t>;
+template class Hull::BasicIncrementalHull<float, std::int64_t>;
+template class Hull::BasicIncrementalHull<double, std::int32_t>;
+template class Hull::BasicIncrementalHull<double, std::int64_t>;
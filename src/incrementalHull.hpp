@@ -0,0 +1,99 @@
+#pragma once
+#ifndef INCREMENTALHULL_HPP
+#define INCREMENTALHULL_HPP
+
+#include "hull.hpp"
+#include <array>
+#include <vector>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+//////////////////////////////////////////////////////////////////////
+/// \class  BasicIncrementalHull
+/// \brief  A convex hull that keeps its facets between calls, so that new
+///         points only retire the facets they can see and stitch new ones
+///         to the horizon around them, rather than rebuilding the hull.
+///         It holds at most maxPoints<Index> points in total, so long
+///         streams of points need 64-bit indices. Instantiated for float
+///         and double points, with 32 or 64-bit indices.
+template <typename Scalar, typename Index> class BasicIncrementalHull {
+    public:
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Default constructor, starts with no points.
+    BasicIncrementalHull() = default;
+
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Add more points to the hull, growing it where needed.
+    /// \param  points      the points to add.
+    /// \return true if added, false if nothing was added because the hull
+    ///         would then hold more than maxPoints<Index> points.
+    bool insert(const BasicPointSpan<Scalar>& points);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Add more points to the hull, growing it where needed.
+    /// \param  points      the points to add.
+    /// \return true if added, false if nothing was added because the hull
+    ///         would then hold more than maxPoints<Index> points.
+    bool insert(const std::vector<Point<Scalar>>& points);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the current hull as an indexed mesh.
+    /// \return the hull, whose vertices index every point in the order
+    ///         they were inserted, empty until the points span a volume.
+    BasicMesh<Index> snapshot() const;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve every point inserted so far.
+    /// \return the points, in the order they were inserted.
+    const std::vector<Point<Scalar>>& points() const noexcept {
+        return m_points;
+    }
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Check if the inserted points span a volume yet.
+    /// \return true if the hull has facets, false otherwise.
+    bool has_volume() const noexcept { return !m_hull.empty(); }
+
+    private:
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Grow the flat span of the points held so far with the new
+    ///         ones, and once it becomes a volume, start the hull from a
+    ///         tetrahedron of the points and add the rest of them to it.
+    /// \param  first       the index of the first new point.
+    void start_hull(const Index& first);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Add a held point to the hull if it lies outside of it.
+    /// \param  pointID     the index of the point to add.
+    void add_to_hull(const Index& pointID);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Find a facet the given point can see, walking across the
+    ///         hull from the last facet made towards the point.
+    /// \param  point       the point to find a facet for.
+    /// \return the id of a visible facet, or -1 if the point is inside.
+    Index find_visible(const Point<Scalar>& point) const;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Find a facet around a vertex the given point can see, by
+    ///         turning about the vertex from one of its facets.
+    /// \param  point       the point to find a facet for.
+    /// \param  vertex      the index of the vertex.
+    /// \param  start       a live facet with the vertex as a corner.
+    /// \return the id of a visible facet, or -1 if there is none.
+    Index find_visible_around(
+        const Point<Scalar>& point, const Index& vertex,
+        const Index& start) const;
+
+    using Triangle = BasicTriangle<Scalar, Index>;
+    using Vertex = Point<Scalar>;
+    using EdgeMap = BasicEdgeMap<Index>;
+
+    std::vector<Vertex> m_points;        ///< Every point inserted so far.
+    std::vector<Triangle> m_hull;        ///< Facet pool, with retired slots.
+    std::vector<Index> m_freeSlots;      ///< Retired facet slots to recycle.
+    std::vector<Index> m_xList;          ///< Facets retired by the last point.
+    std::vector<Index> m_newList;        ///< Facets made by the last point.
+    EdgeMap m_edgeMap;                   ///< Edges of new facets to pair up.
+    Vertex m_middle = Vertex(Scalar(0)); ///< A point strictly inside the hull.
+    Index m_lastFacet = -1;              ///< A live facet to start walks from.
+    std::array<Index, 3> m_span{};       ///< Points spanning the flat start.
+    size_t m_spanSize = 0ULL;            ///< How many points the span has.
+};
+/** The incremental hull of float points with the compact 32-bit index. */
+using IncrementalHull = BasicIncrementalHull<float, int>;
+};     // namespace Hull
+#endif // INCREMENTALHULL_HPP
@@ -0,0 +1,122 @@
+#include "mappedFile.hpp"
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Forward Declarations
+size_t map_granularity() noexcept;
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Destructor
+//////////////////////////////////////////////////////////////////////
+
+Hull::MappedFile::~MappedFile() {
+    unmap();
+#if defined(_WIN32)
+    if (m_mapping != nullptr)
+        CloseHandle(m_mapping);
+    if (m_file != nullptr)
+        CloseHandle(m_file);
+#else
+    if (m_file >= 0)
+        close(m_file);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+Hull::MappedFile::MappedFile(const std::string& path) {
+#if defined(_WIN32)
+    const auto file = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+    m_file = file;
+    LARGE_INTEGER size{};
+    if (GetFileSizeEx(file, &size) == 0)
+        return;
+    m_size = static_cast<size_t>(size.QuadPart);
+    // Empty files cannot be mapped, but there is nothing to map anyway
+    if (m_size > 0ULL) {
+        m_mapping =
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping == nullptr)
+            return;
+    }
+#else
+    m_file = open(path.c_str(), O_RDONLY);
+    struct stat status {};
+    if (m_file < 0 || fstat(m_file, &status) != 0)
+        return;
+    m_size = static_cast<size_t>(status.st_size);
+#endif
+    m_open = true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// map
+//////////////////////////////////////////////////////////////////////
+
+const unsigned char*
+Hull::MappedFile::map(const size_t& offset, const size_t& length) {
+    unmap();
+    if (!m_open || length == 0ULL || offset + length > m_size)
+        return nullptr;
+
+    // Windows have to start on a multiple of the mapping granularity
+    const auto start = offset - offset % map_granularity();
+    const auto viewLength = length + (offset - start);
+#if defined(_WIN32)
+    const auto wideStart = static_cast<unsigned long long>(start);
+    m_view = MapViewOfFile(
+        m_mapping, FILE_MAP_READ, static_cast<DWORD>(wideStart >> 32U),
+        static_cast<DWORD>(wideStart), viewLength);
+    if (m_view == nullptr)
+        return nullptr;
+#else
+    auto* view = mmap(
+        nullptr, viewLength, PROT_READ, MAP_PRIVATE, m_file,
+        static_cast<off_t>(start));
+    if (view == MAP_FAILED)
+        return nullptr;
+    posix_madvise(view, viewLength, POSIX_MADV_SEQUENTIAL);
+    m_view = view;
+#endif
+    m_viewLength = viewLength;
+    return static_cast<const unsigned char*>(m_view) + (offset - start);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// unmap
+//////////////////////////////////////////////////////////////////////
+
+void Hull::MappedFile::unmap() noexcept {
+    if (m_view == nullptr)
+        return;
+#if defined(_WIN32)
+    UnmapViewOfFile(m_view);
+#else
+    munmap(m_view, m_viewLength);
+#endif
+    m_view = nullptr;
+    m_viewLength = 0ULL;
+}
+
+// Find the multiple that mapped windows have to start on.
+size_t map_granularity() noexcept {
+#if defined(_WIN32)
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwAllocationGranularity);
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
@@ -0,0 +1,62 @@
+#pragma once
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+//////////////////////////////////////////////////////////////////////
+/// \class  MappedFile
+/// \brief  A read-only file mapped into memory one window at a time, so
+///         that files far larger than memory can be read in pieces.
+class MappedFile {
+    public:
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Unmap the current window and close the file.
+    ~MappedFile();
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Open a file for mapping, without mapping any of it yet.
+    /// \param  path        the path of the file to open.
+    explicit MappedFile(const std::string& path);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Default copy constructor.
+    MappedFile(const MappedFile& other) = delete;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Default copy-assignment operator.
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Check whether or not the file was opened.
+    /// \return true if the file is open, false otherwise.
+    bool is_open() const noexcept { return m_open; }
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the size of the file.
+    /// \return the size of the file in bytes.
+    size_t size() const noexcept { return m_size; }
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Map a window of the file, replacing the previous window.
+    ///         The pages are hinted to be read sequentially.
+    /// \param  offset      the byte the window starts at.
+    /// \param  length      the number of bytes in the window.
+    /// \return the byte at 'offset', or nullptr if it could not be mapped.
+    const unsigned char* map(const size_t& offset, const size_t& length);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Unmap the current window, if any.
+    void unmap() noexcept;
+
+    private:
+    bool m_open = false;        ///< Set once the file is open.
+    size_t m_size = 0ULL;       ///< The size of the file in bytes.
+    void* m_view = nullptr;     ///< The start of the mapped window.
+    size_t m_viewLength = 0ULL; ///< The mapped length, from m_view.
+#if defined(_WIN32)
+    void* m_file = nullptr;    ///< The file handle.
+    void* m_mapping = nullptr; ///< The file mapping handle.
+#else
+    int m_file = -1; ///< The file descriptor.
+#endif
+};
+};     // namespace Hull
+#endif // MAPPEDFILE_HPP
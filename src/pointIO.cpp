@@ -0,0 +1,459 @@
+#include "pointIO.hpp"
+#include "mappedFile.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+// Forward Declarations
+bool read_raw(const std::string& path, std::vector<vec3>& points);
+bool read_xyz(
+    const std::string& path, std::vector<vec3>& points,
+    Hull::ThreadPool* pool);
+bool read_ply(
+    const std::string& path, std::vector<vec3>& points,
+    Hull::ThreadPool* pool);
+void parse_xyz(const char* begin, const char* end, std::vector<vec3>& points);
+const char*
+parse_float(const char* text, const char* end, float& value) noexcept;
+size_t ply_type_size(const std::string& type) noexcept;
+void run_jobs(
+    const size_t& count, Hull::ThreadPool* pool,
+    const std::function<void(size_t)>& job);
+template <typename Index>
+bool write_ply(
+    const std::string& path, const std::vector<vec3>& points,
+    const Hull::BasicMesh<Index>& mesh);
+template <typename Index>
+bool write_obj(
+    const std::string& path, const std::vector<vec3>& points,
+    const Hull::BasicMesh<Index>& mesh);
+
+// Number of bytes of text each parsing job takes on.
+constexpr size_t textBlockSize(1ULL << 20U);
+// Number of points each job copies out of a binary file.
+constexpr size_t pointBlockSize(1ULL << 16U);
+
+Hull::IO::Format Hull::IO::format_of(const std::string& path) {
+    const auto dot = path.find_last_of('.');
+    if (dot == std::string::npos)
+        return Format::Auto;
+    auto extension = path.substr(dot + 1ULL);
+    std::transform(
+        extension.begin(), extension.end(), extension.begin(),
+        [](const unsigned char& character) {
+            return static_cast<char>(std::tolower(character));
+        });
+    if (extension == "bin" || extension == "raw" || extension == "f32")
+        return Format::Raw;
+    if (extension == "xyz" || extension == "txt" || extension == "pts")
+        return Format::XYZ;
+    if (extension == "ply")
+        return Format::PLY;
+    if (extension == "obj")
+        return Format::OBJ;
+    return Format::Auto;
+}
+
+bool Hull::IO::read_ply_layout(const std::string& path, PlyLayout& layout) {
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+    if (!std::getline(file, line) || line.rfind("ply", 0ULL) != 0ULL)
+        return false;
+
+    // Size up every element, in order, until the vertices are found
+    auto littleEndian(false);
+    auto inVertex(false);
+    auto variableSize(false);
+    auto foundVertex(false);
+    std::array<std::string, 3> types;
+    size_t elementsBytes(0ULL);
+    size_t elementCount(0ULL);
+    size_t elementSize(0ULL);
+    layout = PlyLayout{};
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+        if (keyword == "format") {
+            std::string format;
+            words >> format;
+            littleEndian = format == "binary_little_endian";
+        } else if (keyword == "element") {
+            // Close off the previous element
+            if (inVertex) {
+                layout.stride = elementSize;
+                foundVertex = true;
+            } else if (!foundVertex) {
+                if (variableSize)
+                    return false;
+                elementsBytes += elementCount * elementSize;
+            }
+            std::string name;
+            words >> name >> elementCount;
+            elementSize = 0ULL;
+            inVertex = name == "vertex";
+            if (inVertex)
+                layout.count = elementCount;
+        } else if (keyword == "property") {
+            std::string type;
+            std::string name;
+            words >> type >> name;
+            if (type == "list") {
+                variableSize = true;
+                if (inVertex)
+                    return false;
+                continue;
+            }
+            const auto size = ply_type_size(type);
+            if (size == 0ULL)
+                return false;
+            if (inVertex && (name == "x" || name == "y" || name == "z")) {
+                const auto axis = static_cast<size_t>(name[0] - 'x');
+                layout.coordinate[axis] = elementSize;
+                types[axis] = size == 8ULL ? "double" : type;
+            }
+            elementSize += size;
+        } else if (keyword == "end_header") {
+            if (inVertex) {
+                layout.stride = elementSize;
+                foundVertex = true;
+            }
+            break;
+        }
+    }
+    if (!littleEndian || !foundVertex || layout.stride == 0ULL)
+        return false;
+
+    // Every coordinate has to be there, and all of the same real type
+    const auto isFloat = [](const std::string& type) {
+        return type == "float" || type == "float32";
+    };
+    layout.doubles = types[0] == "double";
+    for (const auto& type : types)
+        if (layout.doubles ? type != "double" : !isFloat(type))
+            return false;
+    layout.packed = !layout.doubles &&
+                    layout.coordinate[1] == layout.coordinate[0] + 4ULL &&
+                    layout.coordinate[2] == layout.coordinate[0] + 8ULL;
+    layout.offset = static_cast<size_t>(file.tellg()) + elementsBytes;
+    return !file.fail();
+}
+
+bool Hull::IO::read_points(
+    const std::string& path, std::vector<vec3>& points, const Format& format,
+    ThreadPool* pool) {
+    points.clear();
+    switch (format == Format::Auto ? format_of(path) : format) {
+    case Format::Raw:
+        return read_raw(path, points);
+    case Format::XYZ:
+        return read_xyz(path, points, pool);
+    case Format::PLY:
+        return read_ply(path, points, pool);
+    default:
+        return false;
+    }
+}
+
+template <typename Index>
+bool Hull::IO::write_mesh(
+    const std::string& path, const std::vector<vec3>& points,
+    const BasicMesh<Index>& mesh, const Format& format) {
+    switch (format == Format::Auto ? format_of(path) : format) {
+    case Format::PLY:
+        return write_ply(path, points, mesh);
+    case Format::OBJ:
+        return write_obj(path, points, mesh);
+    default:
+        return false;
+    }
+}
+
+// Read packed float triples, the whole file at once.
+bool read_raw(const std::string& path, std::vector<vec3>& points) {
+    Hull::MappedFile file(path);
+    if (!file.is_open())
+        return false;
+    points.resize(file.size() / sizeof(vec3));
+    if (points.empty())
+        return true;
+    const auto* bytes = file.map(0ULL, points.size() * sizeof(vec3));
+    if (bytes == nullptr)
+        return false;
+    std::memcpy(points.data(), bytes, points.size() * sizeof(vec3));
+    return true;
+}
+
+// Read the points of a text file, splitting it into blocks of whole lines
+// that are parsed in parallel, then joined in file order.
+bool read_xyz(
+    const std::string& path, std::vector<vec3>& points,
+    Hull::ThreadPool* pool) {
+    Hull::MappedFile file(path);
+    if (!file.is_open())
+        return false;
+    if (file.size() == 0ULL)
+        return true;
+    const auto* text =
+        reinterpret_cast<const char*>(file.map(0ULL, file.size()));
+    if (text == nullptr)
+        return false;
+
+    // Move each block boundary forward to the start of a line
+    const auto* end = text + file.size();
+    std::vector<const char*> bounds{ text };
+    while (bounds.back() != end) {
+        const auto* bound =
+            std::min<const char*>(bounds.back() + textBlockSize, end);
+        bound = std::find(bound, end, '\n');
+        bounds.emplace_back(bound == end ? end : bound + 1);
+    }
+    std::vector<std::vector<vec3>> blockPoints(bounds.size() - 1ULL);
+    run_jobs(blockPoints.size(), pool, [&](const size_t& block) {
+        parse_xyz(bounds[block], bounds[block + 1ULL], blockPoints[block]);
+    });
+    size_t count(0ULL);
+    for (const auto& block : blockPoints)
+        count += block.size();
+    points.reserve(count);
+    for (const auto& block : blockPoints)
+        points.insert(points.end(), block.cbegin(), block.cend());
+    return true;
+}
+
+// Read the vertices of a binary PLY file, converting them to floats.
+bool read_ply(
+    const std::string& path, std::vector<vec3>& points,
+    Hull::ThreadPool* pool) {
+    Hull::IO::PlyLayout layout;
+    if (!Hull::IO::read_ply_layout(path, layout))
+        return false;
+    Hull::MappedFile file(path);
+    const auto length = layout.count * layout.stride;
+    if (!file.is_open() || layout.offset + length > file.size())
+        return false;
+    points.resize(layout.count);
+    if (points.empty())
+        return true;
+    const auto* bytes = file.map(layout.offset, length);
+    if (bytes == nullptr)
+        return false;
+    const auto blocks = (layout.count + pointBlockSize - 1ULL) / pointBlockSize;
+    run_jobs(blocks, pool, [&](const size_t& block) {
+        const auto last =
+            std::min<size_t>(layout.count, (block + 1ULL) * pointBlockSize);
+        for (auto i = block * pointBlockSize; i < last; ++i) {
+            const auto* vertex = bytes + i * layout.stride;
+            for (size_t axis = 0ULL; axis < 3ULL; ++axis) {
+                const auto* value = vertex + layout.coordinate[axis];
+                if (layout.doubles) {
+                    double coordinate(0.0);
+                    std::memcpy(&coordinate, value, sizeof(double));
+                    points[i][static_cast<int>(axis)] =
+                        static_cast<float>(coordinate);
+                } else
+                    std::memcpy(
+                        &points[i][static_cast<int>(axis)], value,
+                        sizeof(float));
+            }
+        }
+    });
+    return true;
+}
+
+// Parse the first 3 numbers of every line in a block of text. Lines that
+// start with '#' or hold fewer than 3 numbers are skipped.
+void parse_xyz(const char* begin, const char* end, std::vector<vec3>& points) {
+    const auto* line = begin;
+    while (line < end) {
+        const auto* lineEnd = std::find(line, end, '\n');
+        if (*line != '#') {
+            vec3 point;
+            const auto* cursor = line;
+            auto axis(0);
+            for (; axis < 3 && cursor != nullptr; ++axis)
+                cursor = parse_float(cursor, lineEnd, point[axis]);
+            if (cursor != nullptr)
+                points.emplace_back(point);
+        }
+        line = lineEnd + (lineEnd == end ? 0 : 1);
+    }
+}
+
+// Parse a decimal number after any separators, returning the character
+// after it or nullptr if there is none. Up to 19 significant digits are
+// scaled by an exact power of ten where possible, so the result is the
+// nearest float but for rare cases of rounding twice.
+const char*
+parse_float(const char* text, const char* end, float& value) noexcept {
+    constexpr std::array<double, 23> powers{
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    while (text < end && (*text == ' ' || *text == '\t' || *text == ',' ||
+                          *text == ';' || *text == '\r'))
+        ++text;
+    const auto negative = text < end && *text == '-';
+    if (text < end && (*text == '-' || *text == '+'))
+        ++text;
+
+    // Gather the significant digits and where the decimal point sits
+    std::uint64_t mantissa(0ULL);
+    auto exponent(0);
+    auto digits(0);
+    auto significant(0);
+    auto fraction(false);
+    for (; text < end; ++text) {
+        if (*text == '.' && !fraction) {
+            fraction = true;
+            continue;
+        }
+        if (*text < '0' || *text > '9')
+            break;
+        ++digits;
+        if (mantissa == 0ULL && *text == '0') {
+            exponent -= fraction ? 1 : 0;
+            continue;
+        }
+        if (significant < 19) {
+            mantissa =
+                mantissa * 10ULL + static_cast<std::uint64_t>(*text - '0');
+            ++significant;
+            exponent -= fraction ? 1 : 0;
+        } else
+            exponent += fraction ? 0 : 1;
+    }
+    if (digits == 0)
+        return nullptr;
+    if (text < end && (*text == 'e' || *text == 'E')) {
+        const auto* cursor = text + 1;
+        const auto negativeExponent = cursor < end && *cursor == '-';
+        if (cursor < end && (*cursor == '-' || *cursor == '+'))
+            ++cursor;
+        if (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            auto written(0);
+            for (; cursor < end && *cursor >= '0' && *cursor <= '9'; ++cursor)
+                written = std::min(written * 10 + (*cursor - '0'), 100000);
+            exponent += negativeExponent ? -written : written;
+            text = cursor;
+        }
+    }
+
+    auto result = static_cast<double>(mantissa);
+    if (mantissa != 0ULL) {
+        if (exponent >= 0 && exponent < 23)
+            result *= powers[static_cast<size_t>(exponent)];
+        else if (exponent < 0 && exponent > -23)
+            result /= powers[static_cast<size_t>(-exponent)];
+        else
+            result *= std::pow(10.0, exponent);
+    }
+    value = static_cast<float>(negative ? -result : result);
+    return text;
+}
+
+// Find the size of a PLY scalar type, 0 if it is not one.
+size_t ply_type_size(const std::string& type) noexcept {
+    if (type == "char" || type == "uchar" || type == "int8" ||
+        type == "uint8")
+        return 1ULL;
+    if (type == "short" || type == "ushort" || type == "int16" ||
+        type == "uint16")
+        return 2ULL;
+    if (type == "int" || type == "uint" || type == "int32" ||
+        type == "uint32" || type == "float" || type == "float32")
+        return 4ULL;
+    if (type == "double" || type == "float64")
+        return 8ULL;
+    return 0ULL;
+}
+
+// Run a job for every index, across the pool if there is one.
+void run_jobs(
+    const size_t& count, Hull::ThreadPool* pool,
+    const std::function<void(size_t)>& job) {
+    if (pool == nullptr || count < 2ULL) {
+        for (size_t i = 0ULL; i < count; ++i)
+            job(i);
+        return;
+    }
+    pool->run(count, job);
+}
+
+// Write a mesh as a binary little-endian PLY file.
+template <typename Index>
+bool write_ply(
+    const std::string& path, const std::vector<vec3>& points,
+    const Hull::BasicMesh<Index>& mesh) {
+    if (mesh.vertices.size() >
+        static_cast<size_t>(std::numeric_limits<std::int32_t>::max()))
+        return false;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    const auto faceCount = mesh.indices.size() / 3ULL;
+    file << "ply\nformat binary_little_endian 1.0\n"
+         << "element vertex " << mesh.vertices.size() << "\n"
+         << "property float x\nproperty float y\nproperty float z\n"
+         << "element face " << faceCount << "\n"
+         << "property list uchar int vertex_indices\nend_header\n";
+
+    // Build the body in memory so it goes out in one write
+    constexpr size_t faceBytes(1ULL + 3ULL * sizeof(std::int32_t));
+    std::vector<char> body(
+        mesh.vertices.size() * sizeof(vec3) + faceCount * faceBytes);
+    auto* cursor = body.data();
+    for (const auto& vertex : mesh.vertices) {
+        std::memcpy(
+            cursor, &points[static_cast<size_t>(vertex)], sizeof(vec3));
+        cursor += sizeof(vec3);
+    }
+    for (size_t face = 0ULL; face < faceCount; ++face) {
+        *cursor++ = 3;
+        for (size_t corner = 0ULL; corner < 3ULL; ++corner) {
+            const auto index =
+                static_cast<std::int32_t>(mesh.indices[face * 3ULL + corner]);
+            std::memcpy(cursor, &index, sizeof(index));
+            cursor += sizeof(index);
+        }
+    }
+    file.write(body.data(), static_cast<std::streamsize>(body.size()));
+    return !file.fail();
+}
+
+// Write a mesh as a Wavefront OBJ file, with enough digits to read every
+// float back exactly.
+template <typename Index>
+bool write_obj(
+    const std::string& path, const std::vector<vec3>& points,
+    const Hull::BasicMesh<Index>& mesh) {
+    std::ofstream file(path, std::ios::trunc);
+    std::array<char, 96> line{};
+    for (const auto& vertex : mesh.vertices) {
+        const auto& point = points[static_cast<size_t>(vertex)];
+        const auto length = std::snprintf(
+            line.data(), line.size(), "v %.9g %.9g %.9g\n",
+            static_cast<double>(point.x()), static_cast<double>(point.y()),
+            static_cast<double>(point.z()));
+        file.write(line.data(), length);
+    }
+    for (size_t face = 0ULL; face + 2ULL < mesh.indices.size(); face += 3ULL)
+        file << "f " << mesh.indices[face] + 1 << ' '
+             << mesh.indices[face + 1ULL] + 1 << ' '
+             << mesh.indices[face + 2ULL] + 1 << '\n';
+    return !file.fail();
+}
+
+// Explicit Instantiations
+template bool Hull::IO::write_mesh(
+    const std::string& path, const std::vector<vec3>& points,
+    const BasicMesh<std::int32_t>& mesh, const Format& format);
+template bool Hull::IO::write_mesh(
+    const std::string& path, const std::vector<vec3>& points,
+    const BasicMesh<std::int64_t>& mesh, const Format& format);
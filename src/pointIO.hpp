@@ -0,0 +1,65 @@
+#ifndef POINTIO_HPP
+#define POINTIO_HPP
+
+#include "hull.hpp"
+#include "threadPool.hpp"
+#include <array>
+#include <string>
+
+/** Namespace encapsulating the point and mesh file formats the hull tools
+read and write. Inputs are memory-mapped rather than read through streams,
+and binary data is assumed to be little-endian, like the host. */
+namespace Hull::IO {
+/** File formats points can be read from and hulls written to. */
+enum class Format {
+    Auto, // picked from the file extension.
+    Raw,  // packed float32 x, y, z triples without a header.
+    XYZ,  // text, the first 3 numbers of each line, '#' lines skipped.
+    PLY,  // binary little-endian PLY, x, y and z of the vertex element.
+    OBJ   // Wavefront text, written only.
+};
+
+/** Where the points of a PLY file are, for reading them in place. */
+struct PlyLayout {
+    // Attributes
+    size_t count = 0ULL;                // the number of vertices.
+    size_t offset = 0ULL;               // the byte the first vertex starts at.
+    size_t stride = 0ULL;               // bytes from a vertex to the next.
+    std::array<size_t, 3> coordinate{}; // byte of x, y and z in a vertex.
+    bool doubles = false;               // the coordinates are float64.
+    bool packed = false;                // x, y and z are consecutive floats.
+};
+
+/** Pick a file format from the extension of a path.
+@param  path    the path to look at.
+@return the format for that extension, Auto if it is not recognized. */
+Format format_of(const std::string& path);
+/** Read the PLY header of a file, finding where its vertices are.
+@param  path    the file to read.
+@param  layout  output location of the vertices.
+@return true if the file is a binary little-endian PLY with a vertex element
+        holding x, y and z, false otherwise. */
+bool read_ply_layout(const std::string& path, PlyLayout& layout);
+/** Read every point of a file into memory. Text is parsed a block of lines
+per job, so the pool speeds up large XYZ files.
+@param  path    the file to read.
+@param  points  output points, in file order.
+@param  format  the format of the file.
+@param  pool    optional pool to spread the parsing across.
+@return true if the file was read, false otherwise. */
+bool read_points(
+    const std::string& path, std::vector<vec3>& points,
+    const Format& format = Format::Auto, ThreadPool* pool = nullptr);
+/** Write an indexed hull to a file, with just the hull vertices.
+Instantiated for 32 and 64-bit indices.
+@param  path    the file to write.
+@param  points  the points the mesh was generated from.
+@param  mesh    the mesh to write.
+@param  format  either PLY or OBJ.
+@return true if the file was written, false otherwise. */
+template <typename Index>
+bool write_mesh(
+    const std::string& path, const std::vector<vec3>& points,
+    const BasicMesh<Index>& mesh, const Format& format = Format::Auto);
+};     // namespace Hull::IO
+#endif // POINTIO_HPP
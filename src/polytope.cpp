@@ -0,0 +1,399 @@
+#include "polytope.hpp"
+#include "dop.hpp"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+
+/** Points of the Minkowski difference of two polytopes that the closest
+point to the origin is searched over, with the weight of each point in it. */
+template <typename Scalar> struct Simplex {
+    // Attributes
+    std::array<Hull::Point<Scalar>, 4> points; // the difference of a and b.
+    std::array<size_t, 4> a{};                 // the vertex of 'a' of each.
+    std::array<size_t, 4> b{};                 // the vertex of 'b' of each.
+    std::array<Scalar, 4> weights{};           // barycentric weight of each.
+    size_t count = 0ULL;                       // the number of points.
+};
+
+// Forward Declarations
+template <typename Scalar>
+bool reduce_simplex(Simplex<Scalar>& simplex) noexcept;
+template <typename Scalar>
+Simplex<Scalar> closest_on_triangle(
+    const Simplex<Scalar>& simplex, const size_t& i, const size_t& j,
+    const size_t& k) noexcept;
+template <typename Scalar>
+Simplex<Scalar> closest_on_segment(
+    const Simplex<Scalar>& simplex, const size_t& i,
+    const size_t& j) noexcept;
+template <typename Scalar>
+Simplex<Scalar> pick(
+    const Simplex<Scalar>& simplex, const std::initializer_list<size_t>& ids,
+    const std::initializer_list<Scalar>& weights) noexcept;
+template <typename Scalar>
+Hull::Point<Scalar> weighted_point(const Simplex<Scalar>& simplex) noexcept;
+
+// Most support points a distance query adds before settling for its answer.
+constexpr size_t maxDistanceIterations(128ULL);
+
+template <typename Scalar>
+template <typename Index>
+Hull::BasicPolytope<Scalar>::BasicPolytope(
+    const BasicPointSpan<Scalar>& points, const BasicMesh<Index>& mesh) {
+    m_vertices.reserve(mesh.vertices.size());
+    for (const auto& vertex : mesh.vertices)
+        m_vertices.emplace_back(points[static_cast<size_t>(vertex)]);
+
+    // Pair up both directions of every face edge, once each
+    std::vector<std::pair<size_t, size_t>> edges;
+    edges.reserve(mesh.indices.size() * 2ULL);
+    for (size_t face = 0ULL; face < mesh.indices.size(); face += 3ULL) {
+        for (size_t edge = 0ULL; edge < 3ULL; ++edge) {
+            const auto from = static_cast<size_t>(mesh.indices[face + edge]);
+            const auto to = static_cast<size_t>(
+                mesh.indices[face + (edge + 1ULL) % 3ULL]);
+            edges.emplace_back(from, to);
+            edges.emplace_back(to, from);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // Lay the neighbours of each vertex out one after another
+    m_offsets.assign(m_vertices.size() + 1ULL, 0ULL);
+    for (const auto& edge : edges)
+        ++m_offsets[edge.first + 1ULL];
+    for (size_t vertex = 0ULL; vertex < m_vertices.size(); ++vertex)
+        m_offsets[vertex + 1ULL] += m_offsets[vertex];
+    m_neighbours.reserve(edges.size());
+    for (const auto& edge : edges)
+        m_neighbours.emplace_back(edge.second);
+
+    // Find the vertex reaching farthest along each direction of a 26-DOP
+    for (size_t direction = 0ULL; direction < 26ULL; ++direction) {
+        const auto* axes = Hull::dopDirections[direction];
+        auto farthest = std::numeric_limits<Scalar>::lowest();
+        for (size_t vertex = 0ULL; vertex < m_vertices.size(); ++vertex) {
+            const auto& point = m_vertices[vertex];
+            const auto distance = point.x() * static_cast<Scalar>(axes[0]) +
+                                  point.y() * static_cast<Scalar>(axes[1]) +
+                                  point.z() * static_cast<Scalar>(axes[2]);
+            if (distance > farthest) {
+                farthest = distance;
+                m_starts[direction] = vertex;
+            }
+        }
+    }
+}
+
+template <typename Scalar>
+size_t Hull::BasicPolytope<Scalar>::support(
+    const Point<Scalar>& direction, size_t& start) const noexcept {
+    if (m_vertices.empty())
+        return SIZE_MAX;
+
+    // Without a start, begin from the nearest of the start directions
+    if (start >= m_vertices.size()) {
+        auto nearest = std::numeric_limits<Scalar>::lowest();
+        for (size_t i = 0ULL; i < 26ULL; ++i) {
+            const auto* axes = Hull::dopDirections[i];
+            const auto length = static_cast<Scalar>(std::sqrt(
+                axes[0] * axes[0] + axes[1] * axes[1] + axes[2] * axes[2]));
+            const auto alignment = (direction.x() * axes[0] +
+                                    direction.y() * axes[1] +
+                                    direction.z() * axes[2]) /
+                                   length;
+            if (alignment > nearest) {
+                nearest = alignment;
+                start = m_starts[i];
+            }
+        }
+    }
+
+    // Climb to the farthest neighbour until none is farther
+    auto best = m_vertices[start].dot(direction);
+    for (auto climbing = true; climbing;) {
+        climbing = false;
+        const auto current = start;
+        for (auto i = m_offsets[current]; i < m_offsets[current + 1ULL]; ++i) {
+            const auto neighbour = m_neighbours[i];
+            const auto distance = m_vertices[neighbour].dot(direction);
+            if (distance > best) {
+                best = distance;
+                start = neighbour;
+                climbing = true;
+            }
+        }
+    }
+    return start;
+}
+
+template <typename Scalar>
+Scalar Hull::distance(
+    const BasicPolytope<Scalar>& a, const BasicPolytope<Scalar>& b,
+    BasicDistanceCache<Scalar>& cache, Point<Scalar>* pointA,
+    Point<Scalar>* pointB) {
+    // Return early if either polytope is empty
+    if (a.size() == 0ULL || b.size() == 0ULL)
+        return Scalar(-1);
+    constexpr auto tolerance =
+        Scalar(64) * std::numeric_limits<Scalar>::epsilon();
+
+    // Start from the support point against the last axis between the two
+    const auto add_support = [&](Simplex<Scalar>& simplex,
+                                 const Point<Scalar>& direction) {
+        const auto vertexA = a.support(Point<Scalar>(Scalar(0)) - direction,
+                                       cache.vertexA);
+        const auto vertexB = b.support(direction, cache.vertexB);
+        const auto index = simplex.count++;
+        simplex.points[index] = a.vertex(vertexA) - b.vertex(vertexB);
+        simplex.a[index] = vertexA;
+        simplex.b[index] = vertexB;
+        simplex.weights[index] = Scalar(1);
+        return index;
+    };
+    Simplex<Scalar> simplex;
+    auto axis = cache.axis;
+    if (axis.dot(axis) <= Scalar(0))
+        axis = b.vertex(0ULL) - a.vertex(0ULL);
+    add_support(simplex, axis);
+    auto closest = simplex.points[0];
+    auto touching(false);
+
+    // Add the support point against the closest point found so far, then
+    // keep the fewest points of the simplex spanning the point closest to
+    // the origin, until the support point gets no closer to it
+    for (size_t iteration = 0ULL; iteration < maxDistanceIterations;
+         ++iteration) {
+        const auto lengthSquared = closest.dot(closest);
+        Simplex<Scalar> next(simplex);
+        const auto index = add_support(next, closest);
+        const auto& point = next.points[index];
+        if (lengthSquared - closest.dot(point) <= tolerance * lengthSquared)
+            break;
+        auto repeated(false);
+        for (size_t i = 0ULL; i < simplex.count; ++i)
+            repeated |= simplex.a[i] == next.a[index] &&
+                        simplex.b[i] == next.b[index];
+        if (repeated)
+            break;
+
+        // The origin inside the simplex means the polytopes overlap
+        if (!reduce_simplex(next)) {
+            simplex = next;
+            touching = true;
+            break;
+        }
+        const auto candidate = weighted_point(next);
+        if (candidate.dot(candidate) >= lengthSquared)
+            break;
+        simplex = next;
+        closest = candidate;
+        auto largest(Scalar(0));
+        for (size_t i = 0ULL; i < simplex.count; ++i)
+            largest = std::max(
+                largest, simplex.points[i].dot(simplex.points[i]));
+        if (closest.dot(closest) <= tolerance * largest) {
+            touching = true;
+            break;
+        }
+    }
+
+    // Weigh the vertices of each polytope as the simplex weighs their
+    // difference to find the closest points
+    auto onA = Point<Scalar>(Scalar(0));
+    auto onB = Point<Scalar>(Scalar(0));
+    for (size_t i = 0ULL; i < simplex.count; ++i) {
+        const auto weight = Point<Scalar>(simplex.weights[i]);
+        onA = onA + a.vertex(simplex.a[i]) * weight;
+        onB = onB + b.vertex(simplex.b[i]) * weight;
+    }
+    if (pointA != nullptr)
+        *pointA = onA;
+    if (pointB != nullptr)
+        *pointB = onB;
+    if (touching)
+        return Scalar(0);
+    cache.axis = closest;
+    return std::sqrt(closest.dot(closest));
+}
+
+// Shrink a simplex to the fewest of its points spanning its point closest
+// to the origin, weighing them to give that point. Returns false, weighing
+// every point, if the origin lies inside a tetrahedron.
+template <typename Scalar>
+bool reduce_simplex(Simplex<Scalar>& simplex) noexcept {
+    const auto& points = simplex.points;
+    if (simplex.count == 1ULL) {
+        simplex.weights[0] = Scalar(1);
+        return true;
+    }
+    if (simplex.count == 2ULL) {
+        simplex = closest_on_segment(simplex, 0ULL, 1ULL);
+        return true;
+    }
+    if (simplex.count == 3ULL) {
+        simplex = closest_on_triangle(simplex, 0ULL, 1ULL, 2ULL);
+        return true;
+    }
+
+    // Search every face of a tetrahedron the origin lies beyond, any face
+    // of a flat one
+    constexpr size_t faces[4][4] = {
+        { 0, 1, 2, 3 }, { 0, 1, 3, 2 }, { 0, 2, 3, 1 }, { 1, 2, 3, 0 }
+    };
+    auto found(false);
+    auto nearest = std::numeric_limits<Scalar>::max();
+    Simplex<Scalar> best;
+    for (const auto& face : faces) {
+        const auto& origin = points[face[0]];
+        const auto normal = (points[face[1]] - origin)
+                                .cross(points[face[2]] - origin);
+        const auto opposite = normal.dot(points[face[3]] - origin);
+        const auto side = -normal.dot(origin);
+        if (opposite != Scalar(0) && side * opposite >= Scalar(0))
+            continue;
+        const auto candidate =
+            closest_on_triangle(simplex, face[0], face[1], face[2]);
+        const auto point = weighted_point(candidate);
+        if (point.dot(point) < nearest) {
+            nearest = point.dot(point);
+            best = candidate;
+            found = true;
+        }
+    }
+    if (found) {
+        simplex = best;
+        return true;
+    }
+
+    // Weigh each point by the volume the origin spans with the face
+    // opposite of it
+    const auto volume = [&points](const size_t& i, const size_t& j,
+                                  const size_t& k) {
+        return points[i].dot(points[j].cross(points[k]));
+    };
+    const std::array<Scalar, 4> volumes{ volume(1, 2, 3), -volume(0, 2, 3),
+                                         volume(0, 1, 3), -volume(0, 1, 2) };
+    const auto total = volumes[0] + volumes[1] + volumes[2] + volumes[3];
+    for (size_t i = 0ULL; i < 4ULL; ++i)
+        simplex.weights[i] = total != Scalar(0) ? volumes[i] / total
+                                                : Scalar(0.25);
+    return false;
+}
+
+// Find the point of a triangle of the simplex closest to the origin, by
+// finding which of its regions the origin projects into (Ericson).
+template <typename Scalar>
+Simplex<Scalar> closest_on_triangle(
+    const Simplex<Scalar>& simplex, const size_t& i, const size_t& j,
+    const size_t& k) noexcept {
+    const auto& a = simplex.points[i];
+    const auto& b = simplex.points[j];
+    const auto& c = simplex.points[k];
+    const auto ab = b - a;
+    const auto ac = c - a;
+    const auto d1 = -ab.dot(a);
+    const auto d2 = -ac.dot(a);
+    if (d1 <= Scalar(0) && d2 <= Scalar(0))
+        return pick(simplex, { i }, { Scalar(1) });
+    const auto d3 = -ab.dot(b);
+    const auto d4 = -ac.dot(b);
+    if (d3 >= Scalar(0) && d4 <= d3)
+        return pick(simplex, { j }, { Scalar(1) });
+    const auto vc = d1 * d4 - d3 * d2;
+    if (vc <= Scalar(0) && d1 >= Scalar(0) && d3 <= Scalar(0))
+        return closest_on_segment(simplex, i, j);
+    const auto d5 = -ab.dot(c);
+    const auto d6 = -ac.dot(c);
+    if (d6 >= Scalar(0) && d5 <= d6)
+        return pick(simplex, { k }, { Scalar(1) });
+    const auto vb = d5 * d2 - d1 * d6;
+    if (vb <= Scalar(0) && d2 >= Scalar(0) && d6 <= Scalar(0))
+        return closest_on_segment(simplex, i, k);
+    const auto va = d3 * d6 - d5 * d4;
+    if (va <= Scalar(0) && d4 - d3 >= Scalar(0) && d5 - d6 >= Scalar(0))
+        return closest_on_segment(simplex, j, k);
+
+    // A triangle too thin to have an inside is closest along an edge
+    const auto total = va + vb + vc;
+    if (!(total > Scalar(0))) {
+        auto best = closest_on_segment(simplex, i, j);
+        for (const auto& edge : { closest_on_segment(simplex, i, k),
+                                  closest_on_segment(simplex, j, k) }) {
+            const auto point = weighted_point(edge);
+            const auto bestPoint = weighted_point(best);
+            if (point.dot(point) < bestPoint.dot(bestPoint))
+                best = edge;
+        }
+        return best;
+    }
+    return pick(
+        simplex, { i, j, k }, { va / total, vb / total, vc / total });
+}
+
+// Find the point of a segment of the simplex closest to the origin.
+template <typename Scalar>
+Simplex<Scalar> closest_on_segment(
+    const Simplex<Scalar>& simplex, const size_t& i,
+    const size_t& j) noexcept {
+    const auto& a = simplex.points[i];
+    const auto ab = simplex.points[j] - a;
+    const auto length = ab.dot(ab);
+    const auto along = -a.dot(ab);
+    if (along <= Scalar(0) || length <= Scalar(0))
+        return pick(simplex, { i }, { Scalar(1) });
+    if (along >= length)
+        return pick(simplex, { j }, { Scalar(1) });
+    const auto t = along / length;
+    return pick(simplex, { i, j }, { Scalar(1) - t, t });
+}
+
+// Copy some points of a simplex into a new one, with the given weights.
+template <typename Scalar>
+Simplex<Scalar> pick(
+    const Simplex<Scalar>& simplex, const std::initializer_list<size_t>& ids,
+    const std::initializer_list<Scalar>& weights) noexcept {
+    Simplex<Scalar> picked;
+    auto weight = weights.begin();
+    for (const auto& id : ids) {
+        picked.points[picked.count] = simplex.points[id];
+        picked.a[picked.count] = simplex.a[id];
+        picked.b[picked.count] = simplex.b[id];
+        picked.weights[picked.count] = *weight++;
+        ++picked.count;
+    }
+    return picked;
+}
+
+// Sum the points of a simplex by their weights.
+template <typename Scalar>
+Hull::Point<Scalar> weighted_point(const Simplex<Scalar>& simplex) noexcept {
+    auto point = Hull::Point<Scalar>(Scalar(0));
+    for (size_t i = 0ULL; i < simplex.count; ++i)
+        point = point + simplex.points[i] *
+                            Hull::Point<Scalar>(simplex.weights[i]);
+    return point;
+}
+
+// Explicit Instantiations
+template class Hull::BasicPolytope<float>;
+template class Hull::BasicPolytope<double>;
+template Hull::BasicPolytope<float>::BasicPolytope(
+    const BasicPointSpan<float>& points, const BasicMesh<std::int32_t>& mesh);
+template Hull::BasicPolytope<float>::BasicPolytope(
+    const BasicPointSpan<float>& points, const BasicMesh<std::int64_t>& mesh);
+template Hull::BasicPolytope<double>::BasicPolytope(
+    const BasicPointSpan<double>& points, const BasicMesh<std::int32_t>& mesh);
+template Hull::BasicPolytope<double>::BasicPolytope(
+    const BasicPointSpan<double>& points, const BasicMesh<std::int64_t>& mesh);
+template float Hull::distance(
+    const BasicPolytope<float>& a, const BasicPolytope<float>& b,
+    BasicDistanceCache<float>& cache, Point<float>* pointA,
+    Point<float>* pointB);
+template double Hull::distance(
+    const BasicPolytope<double>& a, const BasicPolytope<double>& b,
+    BasicDistanceCache<double>& cache, Point<double>* pointA,
+    Point<double>* pointB);
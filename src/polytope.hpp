@@ -0,0 +1,122 @@
+#pragma once
+#ifndef POLYTOPE_HPP
+#define POLYTOPE_HPP
+
+#include "hull.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+/** What a distance query between two polytopes keeps for the next query
+between the same pair, so that queries a frame apart start from the last
+answer. */
+template <typename Scalar> struct BasicDistanceCache {
+    // Attributes
+    size_t vertexA = SIZE_MAX;             // last support vertex of 'a'.
+    size_t vertexB = SIZE_MAX;             // last support vertex of 'b'.
+    Point<Scalar> axis = Point<Scalar>(Scalar(0)); // from 'b' to 'a'.
+};
+/** The distance cache of float polytopes. */
+using DistanceCache = BasicDistanceCache<float>;
+
+//////////////////////////////////////////////////////////////////////
+/// \class  BasicPolytope
+/// \brief  The vertices of a convex hull with the edges between them, for
+///         finding the vertex farthest along a direction by climbing the
+///         edges rather than scanning every vertex.
+template <typename Scalar> class BasicPolytope {
+    public:
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Construct the polytope of a hull, copying its vertices.
+    ///         Instantiated for 32 and 64-bit indices.
+    /// \param  points      the points the mesh was generated from.
+    /// \param  mesh        the indexed hull of those points.
+    template <typename Index>
+    BasicPolytope(
+        const BasicPointSpan<Scalar>& points, const BasicMesh<Index>& mesh);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Construct the polytope of a hull, copying its vertices.
+    /// \param  points      the points the mesh was generated from.
+    /// \param  mesh        the indexed hull of those points.
+    template <typename Index>
+    BasicPolytope(
+        const std::vector<Point<Scalar>>& points, const BasicMesh<Index>& mesh)
+        : BasicPolytope(
+              BasicPointSpan<Scalar>{ points.data(), points.size() }, mesh) {}
+
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of vertices.
+    /// \return the vertex count, 0 if the hull was empty.
+    size_t size() const noexcept { return m_vertices.size(); }
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve a vertex, in the order of the mesh's vertices.
+    /// \param  vertex      the id of the vertex.
+    /// \return the position of the vertex.
+    const Point<Scalar>& vertex(const size_t& vertex) const noexcept {
+        return m_vertices[vertex];
+    }
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the vertices sharing an edge with a vertex.
+    /// \param  vertex      the id of the vertex.
+    /// \param  count       output number of neighbours.
+    /// \return the ids of the neighbours.
+    const size_t* neighbours(const size_t& vertex, size_t& count) const
+        noexcept {
+        count = m_offsets[vertex + 1ULL] - m_offsets[vertex];
+        return m_neighbours.data() + m_offsets[vertex];
+    }
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Find the vertex farthest along a direction, by moving to
+    ///         the farthest neighbour until none is farther. A convex
+    ///         hull has no other local maxima, so starting from the last
+    ///         answer, directions that change little take a few steps.
+    /// \param  direction   the direction to search along.
+    /// \param  start       the vertex to start from, set to the answer.
+    ///                     Out of range starts from the extreme vertex of
+    ///                     the nearest of a fixed set of directions.
+    /// \return the id of the farthest vertex, SIZE_MAX if there are none.
+    size_t support(
+        const Point<Scalar>& direction, size_t& start) const noexcept;
+
+    private:
+    std::vector<Point<Scalar>> m_vertices; ///< The hull vertices.
+    std::vector<size_t> m_offsets;    ///< First neighbour of each vertex.
+    std::vector<size_t> m_neighbours; ///< Neighbours of every vertex.
+    std::array<size_t, 26> m_starts{}; ///< Extreme vertex per direction.
+};
+/** The polytope of float points. */
+using Polytope = BasicPolytope<float>;
+
+/** Find the distance between two polytopes with the
+Gilbert-Johnson-Keerthi algorithm, which searches the Minkowski difference
+of the two for the point closest to the origin using only their supports.
+Instantiated for float and double polytopes.
+@param  a       the first polytope.
+@param  b       the second polytope, in the same frame as the first.
+@param  cache   the support vertices and axis of the last query between
+                the two, updated for the next one.
+@param  pointA  optional output for the point of 'a' closest to 'b'.
+@param  pointB  optional output for the point of 'b' closest to 'a'.
+@return the distance between the polytopes, 0 if they intersect, up to
+        rounding, or -1 if either is empty. */
+template <typename Scalar>
+Scalar distance(
+    const BasicPolytope<Scalar>& a, const BasicPolytope<Scalar>& b,
+    BasicDistanceCache<Scalar>& cache, Point<Scalar>* pointA = nullptr,
+    Point<Scalar>* pointB = nullptr);
+/** Test if two polytopes intersect, using their distance.
+@param  a       the first polytope.
+@param  b       the second polytope, in the same frame as the first.
+@param  cache   the support vertices and axis of the last query between
+                the two, updated for the next one.
+@return true if the polytopes touch or overlap, false otherwise. */
+template <typename Scalar>
+bool intersects(
+    const BasicPolytope<Scalar>& a, const BasicPolytope<Scalar>& b,
+    BasicDistanceCache<Scalar>& cache) {
+    return distance(a, b, cache) == Scalar(0);
+}
+};     // namespace Hull
+#endif // POLYTOPE_HPP
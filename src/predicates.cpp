@@ -0,0 +1,192 @@
+#include "predicates.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// Forward Declarations
+template <typename Scalar>
+double orient3d_exact(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c, const Hull::Point<Scalar>& d) noexcept;
+void two_sum(const double& a, const double& b, double& x, double& y) noexcept;
+void two_product(
+    const double& a, const double& b, double& x, double& y) noexcept;
+size_t grow_expansion(double* e, const size_t& length, double b) noexcept;
+
+// Half of the distance between 1 and the next double (Shewchuk's epsilon).
+constexpr double epsilon(1.1102230246251565e-16);
+// Relative error bound of the floating-point orient3d evaluation.
+constexpr double orient3dBound((7.0 + 56.0 * epsilon) * epsilon);
+// Relative error bound of the floating-point orient2d evaluation.
+constexpr double orient2dBound((3.0 + 16.0 * epsilon) * epsilon);
+
+template <typename Scalar>
+double Hull::Predicates::orient3d(
+    const Point<Scalar>& a, const Point<Scalar>& b, const Point<Scalar>& c,
+    const Point<Scalar>& d) noexcept {
+    const auto adx = static_cast<double>(a.x()) - d.x();
+    const auto bdx = static_cast<double>(b.x()) - d.x();
+    const auto cdx = static_cast<double>(c.x()) - d.x();
+    const auto ady = static_cast<double>(a.y()) - d.y();
+    const auto bdy = static_cast<double>(b.y()) - d.y();
+    const auto cdy = static_cast<double>(c.y()) - d.y();
+    const auto adz = static_cast<double>(a.z()) - d.z();
+    const auto bdz = static_cast<double>(b.z()) - d.z();
+    const auto cdz = static_cast<double>(c.z()) - d.z();
+
+    const auto bdxcdy = bdx * cdy;
+    const auto cdxbdy = cdx * bdy;
+    const auto cdxady = cdx * ady;
+    const auto adxcdy = adx * cdy;
+    const auto adxbdy = adx * bdy;
+    const auto bdxady = bdx * ady;
+    const auto determinant = adz * (bdxcdy - cdxbdy) +
+                             bdz * (cdxady - adxcdy) +
+                             cdz * (adxbdy - bdxady);
+
+    // Trust the sign if it outweighs the worst rounding error
+    const auto permanent =
+        (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+        (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+        (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+    const auto bound = orient3dBound * permanent;
+    if (determinant > bound || -determinant > bound)
+        return determinant;
+    return orient3d_exact(a, b, c, d);
+}
+
+template <typename Scalar>
+double Hull::Predicates::orient2d(
+    const Point<Scalar>& a, const Point<Scalar>& b, const Point<Scalar>& c,
+    const int& axis) noexcept {
+    const auto u = (axis + 1) % 3;
+    const auto v = (axis + 2) % 3;
+    const auto* pa = a.data();
+    const auto* pb = b.data();
+    const auto* pc = c.data();
+
+    // Trust the sign if it outweighs the worst rounding error. Working from
+    // the edges keeps the error relative to the size of the triangle rather
+    // than to how far it lies from the origin.
+    const auto left = (static_cast<double>(pb[u]) - pa[u]) *
+                      (static_cast<double>(pc[v]) - pa[v]);
+    const auto right = (static_cast<double>(pb[v]) - pa[v]) *
+                       (static_cast<double>(pc[u]) - pa[u]);
+    const auto determinant = left - right;
+    const auto bound = orient2dBound * (std::abs(left) + std::abs(right));
+    if (determinant > bound || -determinant > bound)
+        return determinant;
+
+    // Otherwise sum the 6 products of the determinant without rounding,
+    // splitting each into its rounded value and rounding error.
+    const std::array<std::array<double, 2>, 6> factors{
+        { { pa[u], pb[v] },
+          { -static_cast<double>(pa[v]), pb[u] },
+          { pb[u], pc[v] },
+          { -static_cast<double>(pb[v]), pc[u] },
+          { pc[u], pa[v] },
+          { -static_cast<double>(pc[v]), pa[u] } }
+    };
+    std::array<double, 12> expansion{};
+    size_t length(0ULL);
+    for (const auto& [first, second] : factors) {
+        double high(0.0);
+        double low(0.0);
+        two_product(first, second, high, low);
+        length = grow_expansion(expansion.data(), length, low);
+        length = grow_expansion(expansion.data(), length, high);
+    }
+    return length > 0ULL ? expansion[length - 1ULL] : 0.0;
+}
+
+// Evaluate orient3d exactly from the points themselves, as the 4x4
+// determinant with a column of ones. Each of its 24 terms is a product of 3
+// coordinates, which 4 doubles hold exactly, and the terms are summed
+// without rounding into an expansion whose largest component carries the
+// sign.
+template <typename Scalar>
+double orient3d_exact(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c, const Hull::Point<Scalar>& d) noexcept {
+    const std::array<const Hull::Point<Scalar>*, 4> rows{ &a, &b, &c, &d };
+    std::array<int, 4> columns{ 0, 1, 2, 3 };
+    std::array<double, 96> expansion{};
+    size_t length(0ULL);
+    do {
+        // Count inversions for the sign of this permutation
+        auto inversions(0);
+        for (int i = 0; i < 4; ++i)
+            for (int j = i + 1; j < 4; ++j)
+                if (columns[i] > columns[j])
+                    ++inversions;
+
+        // The row taking the column of ones drops out of the product
+        std::array<double, 3> factor{};
+        auto factors(0);
+        for (int row = 0; row < 4; ++row)
+            if (columns[row] != 3)
+                factor[factors++] =
+                    static_cast<double>(rows[row]->data()[columns[row]]);
+        if ((inversions & 1) != 0)
+            factor[0] = -factor[0];
+
+        // Split the product of the first pair, then scale both parts
+        double pairHigh(0.0);
+        double pairLow(0.0);
+        two_product(factor[0], factor[1], pairHigh, pairLow);
+        for (const auto& part : { pairLow, pairHigh }) {
+            double high(0.0);
+            double low(0.0);
+            two_product(part, factor[2], high, low);
+            length = grow_expansion(expansion.data(), length, low);
+            length = grow_expansion(expansion.data(), length, high);
+        }
+    } while (std::next_permutation(columns.begin(), columns.end()));
+    return length > 0ULL ? expansion[length - 1ULL] : 0.0;
+}
+
+// Add two doubles, 'x' being the rounded sum and 'y' its rounding error.
+void two_sum(const double& a, const double& b, double& x, double& y) noexcept {
+    x = a + b;
+    const auto bVirtual = x - a;
+    const auto aVirtual = x - bVirtual;
+    y = (a - aVirtual) + (b - bVirtual);
+}
+
+// Multiply two doubles, 'x' being the rounded product and 'y' its error.
+void two_product(
+    const double& a, const double& b, double& x, double& y) noexcept {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// Add a double to an expansion of non-overlapping components sorted by
+// magnitude, in place, dropping zero components. Returns the new length.
+size_t grow_expansion(double* e, const size_t& length, double b) noexcept {
+    size_t newLength(0ULL);
+    for (size_t i = 0ULL; i < length; ++i) {
+        double sum(0.0);
+        double error(0.0);
+        two_sum(b, e[i], sum, error);
+        b = sum;
+        if (error != 0.0)
+            e[newLength++] = error;
+    }
+    if (b != 0.0 || newLength == 0ULL)
+        e[newLength++] = b;
+    return newLength;
+}
+
+// Explicit Instantiations
+template double Hull::Predicates::orient3d<float>(
+    const Point<float>& a, const Point<float>& b, const Point<float>& c,
+    const Point<float>& d) noexcept;
+template double Hull::Predicates::orient3d<double>(
+    const Point<double>& a, const Point<double>& b, const Point<double>& c,
+    const Point<double>& d) noexcept;
+template double Hull::Predicates::orient2d<float>(
+    const Point<float>& a, const Point<float>& b, const Point<float>& c,
+    const int& axis) noexcept;
+template double Hull::Predicates::orient2d<double>(
+    const Point<double>& a, const Point<double>& b, const Point<double>& c,
+    const int& axis) noexcept;
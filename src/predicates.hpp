@@ -0,0 +1,52 @@
+#ifndef PREDICATES_HPP
+#define PREDICATES_HPP
+
+#include "hull.hpp"
+#include <limits>
+
+/** Namespace encapsulating the exact geometric tests used by the hull. Each
+test first tries a floating-point evaluation with a bound on its rounding
+error, and only falls back to exact arithmetic when that cannot decide. They
+are explicitly instantiated for float and double coordinates. The rounding
+bounds that inexact tests elsewhere allow for live here too. */
+namespace Hull::Predicates {
+/** Half of the distance between 1 and the next value of each scalar type. */
+template <typename Scalar>
+constexpr double unitRoundoff =
+    static_cast<double>(std::numeric_limits<Scalar>::epsilon()) / 2.0;
+/** Find how far rounding may misplace a point relative to the plane of a
+face, when every coordinate lies within an extent of the origin. It is about
+1e-5 of the extent for floats.
+@param  extent  the largest magnitude of any coordinate.
+@return the distance a plane must be moved by to allow for rounding. */
+template <typename Scalar> Scalar plane_margin(const Scalar& extent) noexcept {
+    return extent * static_cast<Scalar>(168.0 * unitRoundoff<Scalar>);
+}
+
+/** Find which side of the plane through 3 points a fourth point lies on.
+@param  a       the first point on the plane.
+@param  b       the second point on the plane.
+@param  c       the third point on the plane.
+@param  d       the point to test.
+@return positive if 'd' lies below the plane, where 'a', 'b' and 'c' appear
+        counter-clockwise when seen from above, negative if above and zero
+        if all 4 points are coplanar. Only the sign is exact. */
+template <typename Scalar>
+double orient3d(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c, const Hull::Point<Scalar>& d) noexcept;
+/** Find which way 3 points turn, seen along one of the coordinate axes.
+@param  a       the first point.
+@param  b       the second point.
+@param  c       the third point.
+@param  axis    the axis to look along, the points are projected onto the
+                plane of the other two.
+@return positive if the projected points turn counter-clockwise, negative
+        if clockwise and zero if they are collinear. Only the sign is
+        exact. */
+template <typename Scalar>
+double orient2d(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c, const int& axis) noexcept;
+};     // namespace Hull::Predicates
+#endif // PREDICATES_HPP
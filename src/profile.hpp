@@ -0,0 +1,91 @@
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+#include "hull.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+/** Whether hulls record phase timings and algorithm counters into Stats.
+Defining it as 0 compiles every recording site out, leaving those fields
+zero, while the peak and culling measurements are always kept. */
+#ifndef HULL_STATS
+#define HULL_STATS 1
+#endif
+
+/** Namespace encapsulating how the engines record their phase timings and
+algorithm counters. Each helper does nothing when HULL_STATS is 0. */
+namespace Hull::Profile {
+/** Whether timings and counters get recorded at all. */
+constexpr bool enabled = HULL_STATS != 0;
+/** The clock phases are timed with. */
+using Clock = std::chrono::steady_clock;
+
+/** Read the clock, if timings are recorded.
+@return the current time, or the clock's epoch if timings are compiled out. */
+inline Clock::time_point now() noexcept {
+    if constexpr (enabled)
+        return Clock::now();
+    else
+        return {};
+}
+/** Add the time since a phase started to its timing, and start the next
+phase from now.
+@param  phase   the timing to add to, in nanoseconds.
+@param  start   the time the phase started, moved on to now. */
+inline void lap(std::uint64_t& phase, Clock::time_point& start) noexcept {
+    if constexpr (enabled) {
+        const auto end = Clock::now();
+        phase += static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                .count());
+        start = end;
+    }
+}
+/** Add to a counter.
+@param  counter the counter to add to.
+@param  amount  how much to add. */
+inline void tally(size_t& counter, const size_t& amount = 1ULL) noexcept {
+    if constexpr (enabled)
+        counter += amount;
+}
+/** Record one insertion's facets, whose new facets each span one edge of
+the horizon it was seen over.
+@param  stats   the stats to record into.
+@param  created the number of facets the insertion created.
+@param  retired the number of facets the insertion retired. */
+inline void insertion(
+    Stats& stats, const size_t& created, const size_t& retired) noexcept {
+    if constexpr (enabled) {
+        ++stats.pointsInserted;
+        stats.facetsCreated += created;
+        stats.facetsRetired += retired;
+        stats.horizonEdges += created;
+        stats.maxHorizon = std::max(stats.maxHorizon, created);
+    }
+}
+/** Add the timings and counters of one hull build to a running total, such
+as across the slabs of the parallel engine or the chunks of a stream.
+@param  total   the stats to add to.
+@param  part    the stats to add. */
+inline void accumulate(Stats& total, const Stats& part) noexcept {
+    if constexpr (enabled) {
+        total.prefilterNs += part.prefilterNs;
+        total.sortNs += part.sortNs;
+        total.flatNs += part.flatNs;
+        total.fileNs += part.fileNs;
+        total.insertNs += part.insertNs;
+        total.renumberNs += part.renumberNs;
+        total.outputNs += part.outputNs;
+        total.pointsInserted += part.pointsInserted;
+        total.pointsInterior += part.pointsInterior;
+        total.visibilityTests += part.visibilityTests;
+        total.coplanarPoints += part.coplanarPoints;
+        total.facetsCreated += part.facetsCreated;
+        total.facetsRetired += part.facetsRetired;
+        total.horizonEdges += part.horizonEdges;
+        total.maxHorizon = std::max(total.maxHorizon, part.maxHorizon);
+    }
+}
+};     // namespace Hull::Profile
+#endif // PROFILE_HPP
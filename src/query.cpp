@@ -0,0 +1,235 @@
+#include "query.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Most faces a hull may have for the Auto method to test every plane.
+constexpr size_t planeFaceLimit(256ULL);
+// Most cells along a side of the cube map of start faces.
+constexpr size_t maxResolution(256ULL);
+// Number of points each job of a batch tests.
+constexpr size_t queryBlockSize(16384ULL);
+
+template <typename Scalar>
+template <typename Index>
+Hull::BasicQuery<Scalar>::BasicQuery(
+    const BasicPointSpan<Scalar>& points, const BasicMesh<Index>& mesh,
+    const QueryMethod& method) {
+    // Gather the plane of every face, and a point inside all of them
+    const auto faceCount = mesh.indices.size() / 3ULL;
+    const auto corner = [&](const size_t& index) {
+        return points[static_cast<size_t>(mesh.vertices[mesh.indices[index]])];
+    };
+    m_center = Point<Scalar>(Scalar(0));
+    for (const auto& vertex : mesh.vertices)
+        m_center = m_center + points[static_cast<size_t>(vertex)];
+    if (!mesh.vertices.empty())
+        m_center = m_center / Point<Scalar>(Scalar(mesh.vertices.size()));
+    m_planes.reserve(faceCount * 4ULL);
+    auto hasVolume = faceCount >= 4ULL;
+    for (size_t face = 0ULL; face < faceCount; ++face) {
+        const auto v0 = corner(face * 3ULL);
+        const auto normal = Point<Scalar>::normalize(
+            (corner(face * 3ULL + 1ULL) - v0)
+                .cross(corner(face * 3ULL + 2ULL) - v0));
+        m_planes.insert(
+            m_planes.end(),
+            { normal.x(), normal.y(), normal.z(), normal.dot(v0) });
+        if (!(normal.dot(m_center) < normal.dot(v0)))
+            hasVolume = false;
+    }
+
+    // A hull without volume, including one with no faces at all, contains
+    // nothing, so it keeps no planes to test
+    m_method = method;
+    if (method == QueryMethod::Auto)
+        m_method = faceCount > planeFaceLimit ? QueryMethod::Walk
+                                              : QueryMethod::Planes;
+    if (!hasVolume) {
+        m_empty = true;
+        m_method = QueryMethod::Planes;
+        m_planes.clear();
+    }
+    if (m_method == QueryMethod::Planes)
+        return;
+
+    // Each face spans a cone from the center, bounded by a plane through
+    // the center and each of its edges, whose normals point into the cone
+    m_edges.resize(faceCount);
+    m_neighbours.resize(faceCount);
+    for (size_t face = 0ULL; face < faceCount; ++face) {
+        for (size_t edge = 0ULL; edge < 3ULL; ++edge) {
+            const auto from = corner(face * 3ULL + edge) - m_center;
+            const auto to =
+                corner(face * 3ULL + (edge + 1ULL) % 3ULL) - m_center;
+            m_edges[face][edge] = from.cross(to);
+            m_neighbours[face][edge] =
+                static_cast<size_t>(mesh.adjacency[face * 3ULL + edge]);
+        }
+    }
+
+    // Look up the face in the direction of the center of every cell of a
+    // cube map, with about a cell per face, each walk starting from the last
+    m_resolution = std::clamp<size_t>(
+        static_cast<size_t>(std::sqrt(static_cast<double>(faceCount) / 6.0)),
+        1ULL, maxResolution);
+    m_startFaces.resize(6ULL * m_resolution * m_resolution);
+    size_t face(0ULL);
+    const auto step = Scalar(2) / static_cast<Scalar>(m_resolution);
+    for (size_t side = 0ULL; side < 6ULL; ++side) {
+        const auto axis = side / 2ULL;
+        for (size_t u = 0ULL; u < m_resolution; ++u) {
+            for (size_t v = 0ULL; v < m_resolution; ++v) {
+                Point<Scalar> direction;
+                auto* coordinates = direction.data();
+                coordinates[axis] =
+                    side % 2ULL == 0ULL ? Scalar(1) : Scalar(-1);
+                coordinates[(axis + 1ULL) % 3ULL] =
+                    (static_cast<Scalar>(u) + Scalar(0.5)) * step - Scalar(1);
+                coordinates[(axis + 2ULL) % 3ULL] =
+                    (static_cast<Scalar>(v) + Scalar(0.5)) * step - Scalar(1);
+                face = find_face(direction, face);
+                m_startFaces[cell_of(direction)] = face;
+            }
+        }
+    }
+}
+
+template <typename Scalar>
+bool Hull::BasicQuery<Scalar>::contains(
+    const Point<Scalar>& point) const noexcept {
+    if (m_empty)
+        return false;
+    if (m_method == QueryMethod::Planes) {
+        unsigned char inside(0);
+        const auto* coordinates = point.data();
+        Simd::inside_planes(
+            coordinates, coordinates + 1, coordinates + 2, 1ULL,
+            m_planes.data(), m_planes.size() / 4ULL, &inside);
+        return inside != 0;
+    }
+
+    // The center is inside, and so is everything below the face in the
+    // direction of a point
+    const auto direction = point - m_center;
+    if (direction.dot(direction) <= Scalar(0))
+        return true;
+    const auto face = find_face(direction, m_startFaces[cell_of(direction)]);
+    const auto* plane = m_planes.data() + face * 4ULL;
+    return (point.x() * plane[0] + point.y() * plane[1]) +
+               point.z() * plane[2] <
+           plane[3];
+}
+
+template <typename Scalar>
+void Hull::BasicQuery<Scalar>::contains(
+    const BasicPointSpan<Scalar>& points, std::vector<unsigned char>& inside,
+    ThreadPool* pool) const {
+    if (m_empty) {
+        inside.assign(points.count, 0);
+        return;
+    }
+    inside.resize(points.count);
+    const auto blocks = (points.count + queryBlockSize - 1ULL) / queryBlockSize;
+    const auto test_block = [&](const size_t& block) {
+        const auto first = block * queryBlockSize;
+        const auto last = std::min(points.count, first + queryBlockSize);
+        if (m_method == QueryMethod::Walk) {
+            for (auto i = first; i < last; ++i)
+                inside[i] = contains(points[i]) ? 1 : 0;
+            return;
+        }
+
+        // Copy the block into structure-of-arrays form for the kernel
+        const auto count = last - first;
+        std::vector<Scalar> coordinates(count * 3ULL);
+        for (size_t i = 0ULL; i < count; ++i) {
+            const auto point = points[first + i];
+            coordinates[i] = point.x();
+            coordinates[count + i] = point.y();
+            coordinates[count * 2ULL + i] = point.z();
+        }
+        Simd::inside_planes(
+            coordinates.data(), coordinates.data() + count,
+            coordinates.data() + count * 2ULL, count, m_planes.data(),
+            m_planes.size() / 4ULL, inside.data() + first);
+    };
+    if (pool == nullptr || blocks < 2ULL) {
+        for (size_t block = 0ULL; block < blocks; ++block)
+            test_block(block);
+        return;
+    }
+    pool->run(blocks, test_block);
+}
+
+// Walk from face to face across the edge the direction lies beyond, until
+// reaching the face whose cone holds it. Rounding can leave a walk circling
+// a vertex, so after visiting as many faces as there are, every face gets
+// tested in turn.
+template <typename Scalar>
+size_t Hull::BasicQuery<Scalar>::find_face(
+    const Point<Scalar>& direction, const size_t& start) const noexcept {
+    auto face(start);
+    for (size_t steps = 0ULL; steps < m_edges.size(); ++steps) {
+        const auto edge = exit_edge(face, direction);
+        if (edge == 3ULL)
+            return face;
+        face = m_neighbours[face][edge];
+    }
+    for (face = 0ULL; face < m_edges.size(); ++face)
+        if (exit_edge(face, direction) == 3ULL)
+            return face;
+    return start;
+}
+
+template <typename Scalar>
+size_t Hull::BasicQuery<Scalar>::exit_edge(
+    const size_t& face, const Point<Scalar>& direction) const noexcept {
+    const auto& edges = m_edges[face];
+    for (size_t edge = 0ULL; edge < 3ULL; ++edge)
+        if (edges[edge].dot(direction) < Scalar(0))
+            return edge;
+    return 3ULL;
+}
+
+template <typename Scalar>
+size_t Hull::BasicQuery<Scalar>::cell_of(
+    const Point<Scalar>& direction) const noexcept {
+    // Project onto the side of the cube facing the direction the most
+    const auto* coordinates = direction.data();
+    size_t axis(0ULL);
+    for (size_t other = 1ULL; other < 3ULL; ++other)
+        if (std::abs(coordinates[other]) > std::abs(coordinates[axis]))
+            axis = other;
+    const auto length = std::abs(coordinates[axis]);
+    const auto side =
+        axis * 2ULL + (coordinates[axis] < Scalar(0) ? 1ULL : 0ULL);
+    const auto resolution = static_cast<Scalar>(m_resolution);
+    const auto cell = [&](const Scalar& coordinate) {
+        const auto scaled =
+            (coordinate / length + Scalar(1)) * Scalar(0.5) * resolution;
+        return std::min<size_t>(
+            static_cast<size_t>(std::max(scaled, Scalar(0))),
+            m_resolution - 1ULL);
+    };
+    return (side * m_resolution + cell(coordinates[(axis + 1ULL) % 3ULL])) *
+               m_resolution +
+           cell(coordinates[(axis + 2ULL) % 3ULL]);
+}
+
+// Explicit Instantiations
+template class Hull::BasicQuery<float>;
+template class Hull::BasicQuery<double>;
+template Hull::BasicQuery<float>::BasicQuery(
+    const BasicPointSpan<float>& points, const BasicMesh<std::int32_t>& mesh,
+    const QueryMethod& method);
+template Hull::BasicQuery<float>::BasicQuery(
+    const BasicPointSpan<float>& points, const BasicMesh<std::int64_t>& mesh,
+    const QueryMethod& method);
+template Hull::BasicQuery<double>::BasicQuery(
+    const BasicPointSpan<double>& points, const BasicMesh<std::int32_t>& mesh,
+    const QueryMethod& method);
+template Hull::BasicQuery<double>::BasicQuery(
+    const BasicPointSpan<double>& points, const BasicMesh<std::int64_t>& mesh,
+    const QueryMethod& method);
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include "hull.hpp"
+#include "threadPool.hpp"
+#include <array>
+#include <vector>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+/** Ways a query can find whether points lie inside a hull. */
+enum class QueryMethod {
+    Auto,   // planes for small hulls, the walk for large ones.
+    Planes, // test every face plane, many points at once, stopping early.
+    Walk    // walk the faces towards the one above each point.
+};
+
+//////////////////////////////////////////////////////////////////////
+/// \class  BasicQuery
+/// \brief  Tests whether points lie inside a convex hull, built once from
+///         its indexed mesh and then shared by any number of threads.
+///         Small hulls test each point against every face plane with the
+///         vectorized kernels. Large hulls find the face lying in the
+///         direction of each point from the hull's center by walking the
+///         face adjacency, from a face looked up in a cube map of
+///         directions, so each point only tests a few faces.
+template <typename Scalar> class BasicQuery {
+    public:
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a query for the hull of some points.
+    ///         Instantiated for 32 and 64-bit indices.
+    /// \param  points      the points the mesh was generated from.
+    /// \param  mesh        the indexed hull of those points.
+    /// \param  method      how points get tested against the hull.
+    template <typename Index>
+    BasicQuery(
+        const BasicPointSpan<Scalar>& points, const BasicMesh<Index>& mesh,
+        const QueryMethod& method = QueryMethod::Auto);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a query for the hull of some points.
+    /// \param  points      the points the mesh was generated from.
+    /// \param  mesh        the indexed hull of those points.
+    /// \param  method      how points get tested against the hull.
+    template <typename Index>
+    BasicQuery(
+        const std::vector<Point<Scalar>>& points, const BasicMesh<Index>& mesh,
+        const QueryMethod& method = QueryMethod::Auto)
+        : BasicQuery(
+              BasicPointSpan<Scalar>{ points.data(), points.size() }, mesh,
+              method) {}
+
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the method the points get tested with.
+    /// \return Planes or Walk, never Auto.
+    QueryMethod method() const noexcept { return m_method; }
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Test if a point lies strictly inside the hull. Points on
+    ///         its boundary may go either way, up to rounding, and a hull
+    ///         without volume contains nothing.
+    /// \param  point       the point to test.
+    /// \return true if the point is inside, false otherwise.
+    bool contains(const Point<Scalar>& point) const noexcept;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Test if each of many points lies strictly inside the hull,
+    ///         a block of points per job.
+    /// \param  points      the view of the points to test.
+    /// \param  inside      output flag per point, 1 if inside, all 0 for
+    ///                     a hull without volume.
+    /// \param  pool        optional pool to spread the blocks across.
+    void contains(
+        const BasicPointSpan<Scalar>& points,
+        std::vector<unsigned char>& inside, ThreadPool* pool = nullptr) const;
+
+    private:
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Find the face lying in a direction from the center.
+    /// \param  direction   the direction to find the face in.
+    /// \param  start       the face to start walking from.
+    /// \return the face whose cone from the center holds the direction.
+    size_t find_face(
+        const Point<Scalar>& direction, const size_t& start) const noexcept;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Test if a direction from the center lies within the cone
+    ///         a face spans from it, or which edge it leaves through.
+    /// \param  face        the face to test.
+    /// \param  direction   the direction to test.
+    /// \return the first edge the direction lies beyond, or 3 if none.
+    size_t exit_edge(
+        const size_t& face, const Point<Scalar>& direction) const noexcept;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Find the cube map cell a direction falls in.
+    /// \param  direction   a direction other than zero.
+    /// \return the index of the cell.
+    size_t cell_of(const Point<Scalar>& direction) const noexcept;
+
+    QueryMethod m_method = QueryMethod::Planes; ///< How points get tested.
+    bool m_empty = false;             ///< If the hull has no volume.
+    std::vector<Scalar> m_planes;     ///< Normal and offset of each face.
+    Point<Scalar> m_center;           ///< A point inside the hull.
+    std::vector<std::array<Point<Scalar>, 3>> m_edges; ///< Cone of each face.
+    std::vector<std::array<size_t, 3>> m_neighbours; ///< Across each edge.
+    std::vector<size_t> m_startFaces; ///< Face to walk from, per cell.
+    size_t m_resolution = 0ULL;       ///< Cells along a side of the cube.
+};
+/** The query for float points. */
+using Query = BasicQuery<float>;
+};     // namespace Hull
+#endif // QUERY_HPP
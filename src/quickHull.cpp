@@ -0,0 +1,293 @@
+#include "hull.hpp"
+#include "predicates.hpp"
+#include "profile.hpp"
+#include "simd.hpp"
+#include "workspace.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// Forward Declarations
+template <typename Scalar, typename Index>
+bool quick_hull3D(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    Hull::BasicWorkspace<Scalar, Index>& workspace);
+template <typename Scalar, typename Index>
+bool initial_simplex(
+    const std::vector<Hull::Point<Scalar>>& pts, const Index& count,
+    std::array<Index, 4>& simplex) noexcept;
+template <typename Scalar, typename Index>
+void simplex_hull(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::array<Index, 4>& simplex, const Hull::Point<Scalar>& middle,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull);
+template <typename Scalar>
+Scalar coordinate_scale(const std::vector<Hull::Point<Scalar>>& pts) noexcept;
+template <typename Scalar, typename Index>
+void gather_planes(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Index>& facets, const Scalar& scale,
+    Hull::Simd::BasicPlanes<Scalar>& planes, std::vector<Scalar>& margins);
+template <typename Scalar, typename Index>
+Index find_visible(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    const std::vector<Index>& facets,
+    const Hull::Simd::BasicPlanes<Scalar>& planes,
+    const std::vector<Scalar>& margins, const Hull::Point<Scalar>& point);
+template <typename Scalar, typename Index>
+bool is_visible(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const Hull::BasicTriangle<Scalar, Index>& triangle,
+    const Hull::Point<Scalar>& point) noexcept;
+template <typename Scalar>
+Hull::Point<Scalar> facet_normal(
+    const Hull::Point<Scalar>& a, const Hull::Point<Scalar>& b,
+    const Hull::Point<Scalar>& c) noexcept;
+template <typename Scalar, typename Index>
+void add_point(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull,
+    std::vector<Index>& freeSlots, std::vector<Index>& xList,
+    std::vector<Index>& newList, Hull::BasicEdgeMap<Index>& edgeMap,
+    const Index& pointID, const Index& hvis);
+
+// Build a hull by always adding the farthest point above some facet, which
+// skips most of the facets an insertion order would create and retire for
+// clouds whose points are mostly interior (QuickHull). Shares the facet
+// creation and stitching of the incremental builder, all in the workspace's
+// buffers. Returns false, leaving no hull, if the points do not span a
+// volume.
+template <typename Scalar, typename Index>
+bool quick_hull3D(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    Hull::BasicWorkspace<Scalar, Index>& workspace) {
+    auto& hull = workspace.hull;
+    auto& stats = workspace.stats;
+    auto clock = Hull::Profile::now();
+    hull.clear();
+    std::array<Index, 4> simplex{};
+    if (!initial_simplex(pts, static_cast<Index>(pts.size()), simplex))
+        return false;
+
+    // Start from the tetrahedron
+    const auto middle = (pts[simplex[0]] + pts[simplex[1]] + pts[simplex[2]] +
+                         pts[simplex[3]]) /
+                        Hull::Point<Scalar>(Scalar(4));
+    simplex_hull(pts, simplex, middle, hull);
+    Hull::Profile::tally(stats.facetsCreated, hull.size());
+    Hull::Profile::lap(stats.flatNs, clock);
+
+    // Every point above a facet goes into the outside set of the facet it
+    // is farthest above, and each facet tracks its farthest point.
+    auto& facetPoints = workspace.facetPoints;
+    auto& farthestPoint = workspace.farthestPoint;
+    auto& farthestDistance = workspace.farthestDistance;
+    auto& nextPoint = workspace.nextPoint;
+    facetPoints.assign(hull.size(), -1);
+    farthestPoint.assign(hull.size(), -1);
+    farthestDistance.assign(hull.size(), Scalar(0));
+    nextPoint.assign(pts.size(), -1);
+    // Points are only taken above a facet once that is certain, which the
+    // float test settles unless a point lies within its rounding margin.
+    const auto scale = coordinate_scale(pts);
+    auto& planes = workspace.planes;
+    auto& margins = workspace.margins;
+    const auto file_point = [&](const Index& id,
+                                const std::vector<Index>& facets) {
+        const auto& point = pts[id];
+        auto bestDistance(Scalar(0));
+        const auto found = Hull::Simd::farthest_above(
+            planes, point.x(), point.y(), point.z(), bestDistance);
+        Hull::Profile::tally(stats.visibilityTests);
+        if (found < 0) {
+            Hull::Profile::tally(stats.pointsInterior);
+            return;
+        }
+        auto bestFacet = facets[found];
+        if (bestDistance <= Scalar(2) * margins[found] &&
+            !is_visible(pts, hull[bestFacet], point)) {
+            // Too close to call, settle for any facet it surely sees
+            bestFacet = find_visible(pts, hull, facets, planes, margins, point);
+            if (bestFacet < 0) {
+                Hull::Profile::tally(stats.pointsInterior);
+                return;
+            }
+            bestDistance = Scalar(0);
+        }
+        nextPoint[id] = facetPoints[bestFacet];
+        facetPoints[bestFacet] = id;
+        if (bestDistance > farthestDistance[bestFacet] ||
+            farthestPoint[bestFacet] < 0) {
+            farthestDistance[bestFacet] = bestDistance;
+            farthestPoint[bestFacet] = id;
+        }
+    };
+    auto& newList = workspace.newList;
+    newList.assign({ 0, 1, 2, 3 });
+    gather_planes(pts, hull, newList, scale, planes, margins);
+    const auto maxPts(static_cast<Index>(pts.size()));
+    for (Index pointID = 0; pointID < maxPts; ++pointID)
+        if (std::find(simplex.cbegin(), simplex.cend(), pointID) ==
+            simplex.cend())
+            file_point(pointID, newList);
+    Hull::Profile::lap(stats.fileNs, clock);
+
+    // Keep adding the farthest point of any facet with an outside set
+    auto& freeSlots = workspace.freeSlots;
+    auto& xList = workspace.xList;
+    auto& pending = workspace.facets;
+    freeSlots.clear();
+    pending.assign(newList.cbegin(), newList.cend());
+    while (!pending.empty()) {
+        const auto hullID = pending.back();
+        pending.pop_back();
+        if (hull[hullID].keep == 0 || facetPoints[hullID] < 0)
+            continue;
+
+        const auto eye = farthestPoint[hullID];
+        add_point(
+            pts, hull, freeSlots, xList, newList, workspace.edgeMap, eye,
+            hullID);
+        Hull::Profile::insertion(stats, newList.size(), xList.size());
+        facetPoints.resize(hull.size(), -1);
+        farthestPoint.resize(hull.size(), -1);
+        farthestDistance.resize(hull.size(), Scalar(0));
+        for (const auto& newID : newList) {
+            facetPoints[newID] = -1;
+            farthestPoint[newID] = -1;
+            farthestDistance[newID] = Scalar(0);
+        }
+
+        // Hand the outside sets of the retired facets to the new facets,
+        // points above none of them are now inside the hull.
+        gather_planes(pts, hull, newList, scale, planes, margins);
+        for (const auto& deadID : xList) {
+            auto outside = facetPoints[deadID];
+            facetPoints[deadID] = -1;
+            while (outside >= 0) {
+                const auto next = nextPoint[outside];
+                if (outside != eye)
+                    file_point(outside, newList);
+                outside = next;
+            }
+        }
+        for (const auto& newID : newList)
+            if (facetPoints[newID] >= 0)
+                pending.emplace_back(newID);
+
+        // The retired facets are no longer referenced, recycle their slots.
+        freeSlots.insert(freeSlots.end(), xList.cbegin(), xList.cend());
+    }
+    Hull::Profile::lap(stats.insertNs, clock);
+    return true;
+}
+
+// Find 4 of the first 'count' points spanning a volume, starting from the
+// most distant pair of axis extremes and then the points farthest from their
+// line and plane.
+template <typename Scalar, typename Index>
+bool initial_simplex(
+    const std::vector<Hull::Point<Scalar>>& pts, const Index& count,
+    std::array<Index, 4>& simplex) noexcept {
+    // Find the extreme points along each axis
+    std::array<Index, 6> extremes{};
+    const auto maxPts(count);
+    for (Index pointID = 0; pointID < maxPts; ++pointID) {
+        for (int axis = 0; axis < 3; ++axis) {
+            const auto& point = pts[pointID];
+            if (point.data()[axis] < pts[extremes[axis * 2]].data()[axis])
+                extremes[axis * 2] = pointID;
+            if (point.data()[axis] > pts[extremes[axis * 2 + 1]].data()[axis])
+                extremes[axis * 2 + 1] = pointID;
+        }
+    }
+
+    // Pick the most distant pair of extremes
+    auto best(Scalar(0));
+    for (const auto& first : extremes) {
+        for (const auto& second : extremes) {
+            const auto delta = pts[second] - pts[first];
+            if (delta.dot(delta) > best) {
+                best = delta.dot(delta);
+                simplex[0] = first;
+                simplex[1] = second;
+            }
+        }
+    }
+    if (best <= Scalar(0))
+        return false;
+
+    // Pick the point farthest from their line
+    const auto& origin = pts[simplex[0]];
+    const auto direction = pts[simplex[1]] - origin;
+    best = Scalar(0);
+    for (Index pointID = 0; pointID < maxPts; ++pointID) {
+        const auto cross = direction.cross(pts[pointID] - origin);
+        if (cross.dot(cross) > best) {
+            best = cross.dot(cross);
+            simplex[2] = pointID;
+        }
+    }
+    if (best <= Scalar(0))
+        return false;
+
+    // Pick the point farthest from their plane
+    const auto normal = direction.cross(pts[simplex[2]] - origin);
+    best = Scalar(0);
+    for (Index pointID = 0; pointID < maxPts; ++pointID) {
+        const auto distance = std::abs(normal.dot(pts[pointID] - origin));
+        if (distance > best) {
+            best = distance;
+            simplex[3] = pointID;
+        }
+    }
+    return best > Scalar(0) &&
+           Hull::Predicates::orient3d(
+               pts[simplex[0]], pts[simplex[1]], pts[simplex[2]],
+               pts[simplex[3]]) != 0.0;
+}
+
+// Replace a hull with the 4 facets of a tetrahedron, each facing away from
+// 'middle'.
+template <typename Scalar, typename Index>
+void simplex_hull(
+    const std::vector<Hull::Point<Scalar>>& pts,
+    const std::array<Index, 4>& simplex, const Hull::Point<Scalar>& middle,
+    std::vector<Hull::BasicTriangle<Scalar, Index>>& hull) {
+    hull.assign({ { 0, 1, simplex[0], simplex[1], simplex[2], 1, 3, 2 },
+                  { 1, 1, simplex[0], simplex[1], simplex[3], 0, 3, 2 },
+                  { 2, 1, simplex[0], simplex[2], simplex[3], 0, 3, 1 },
+                  { 3, 1, simplex[1], simplex[2], simplex[3], 0, 2, 1 } });
+    for (auto& triangle : hull) {
+        auto normal =
+            facet_normal(pts[triangle.a], pts[triangle.b], pts[triangle.c]);
+        if (Hull::Predicates::orient3d(
+                pts[triangle.a], pts[triangle.b], pts[triangle.c], middle) <
+            0.0)
+            normal = -normal;
+        triangle.er = normal.x();
+        triangle.ec = normal.y();
+        triangle.ez = normal.z();
+    }
+}
+
+// Explicit Instantiations
+#define INSTANTIATE_QUICKHULL(Scalar, Index)                                   \
+    template bool quick_hull3D<Scalar, Index>(                                 \
+        const std::vector<Hull::Point<Scalar>>& pts,                           \
+        Hull::BasicWorkspace<Scalar, Index>& workspace);                       \
+    template bool initial_simplex(                                             \
+        const std::vector<Hull::Point<Scalar>>& pts, const Index& count,       \
+        std::array<Index, 4>& simplex) noexcept;                               \
+    template void simplex_hull(                                                \
+        const std::vector<Hull::Point<Scalar>>& pts,                           \
+        const std::array<Index, 4>& simplex,                                   \
+        const Hull::Point<Scalar>& middle,                                     \
+        std::vector<Hull::BasicTriangle<Scalar, Index>>& hull);
+INSTANTIATE_QUICKHULL(float, std::int32_t);
+INSTANTIATE_QUICKHULL(float, std::int64_t);
+INSTANTIATE_QUICKHULL(double, std::int32_t);
+INSTANTIATE_QUICKHULL(double, std::int64_t);
+#undef INSTANTIATE_QUICKHULL
@@ -0,0 +1,56 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <array>
+#include <cstdint>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+/** Counter-based random number generator, Philox4x32-10 (Salmon et al.,
+"Parallel random numbers: as easy as 1, 2, 3"). Each block of 4 numbers
+depends only on the key and on its own counter, so any block can be drawn
+without drawing the ones before it, on any thread. */
+struct Philox {
+    /** A counter, or the 4 random numbers drawn from it. */
+    using Block = std::array<std::uint32_t, 4>;
+
+    // Attributes
+    std::array<std::uint32_t, 2> key{}; // the low and high words of the seed.
+
+    // Methods
+    /** Construct a generator keyed on a seed.
+    @param  seed    the seed every block is drawn from. */
+    explicit Philox(const std::uint64_t& seed) noexcept
+        : key{ static_cast<std::uint32_t>(seed),
+               static_cast<std::uint32_t>(seed >> 32U) } {}
+    /** Draw the block of random numbers belonging to a counter.
+    @param  counter the counter to draw from.
+    @return 4 uniformly distributed 32-bit numbers. */
+    Block operator()(Block counter) const noexcept {
+        auto roundKey(key);
+        for (int round = 0; round < 10; ++round) {
+            const auto product0 = std::uint64_t{ 0xD2511F53U } * counter[0];
+            const auto product1 = std::uint64_t{ 0xCD9E8D57U } * counter[2];
+            counter = {
+                static_cast<std::uint32_t>(product1 >> 32U) ^ counter[1] ^
+                    roundKey[0],
+                static_cast<std::uint32_t>(product1),
+                static_cast<std::uint32_t>(product0 >> 32U) ^ counter[3] ^
+                    roundKey[1],
+                static_cast<std::uint32_t>(product0)
+            };
+            roundKey[0] += 0x9E3779B9U;
+            roundKey[1] += 0xBB67AE85U;
+        }
+        return counter;
+    }
+    /** Convert a random number to a float in [0, 1), keeping the 24 bits a
+    float can hold exactly.
+    @param  bits    the random number.
+    @return a uniformly distributed float. */
+    static float to_unit(const std::uint32_t& bits) noexcept {
+        return static_cast<float>(bits >> 8U) * 0x1p-24F;
+    }
+};
+};     // namespace Hull
+#endif // RANDOM_HPP
@@ -0,0 +1,462 @@
+#include "simd.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define HULL_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define HULL_TARGET_AVX2
+#define HULL_TARGET_AVX512
+#else
+#define HULL_TARGET_AVX2 __attribute__((target("avx2")))
+#define HULL_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#endif
+
+// Forward Declarations
+template <typename Scalar>
+void inside_planes_scalar(
+    const Scalar* x, const Scalar* y, const Scalar* z, const size_t& begin,
+    const size_t& count, const Scalar* planes, const size_t& planeCount,
+    unsigned char* inside) noexcept;
+template <typename Scalar>
+int first_above_scalar(
+    const Hull::Simd::BasicPlanes<Scalar>& planes, const Scalar& x,
+    const Scalar& y, const Scalar& z) noexcept;
+template <typename Scalar>
+int farthest_above_scalar(
+    const Hull::Simd::BasicPlanes<Scalar>& planes, const Scalar& x,
+    const Scalar& y, const Scalar& z, Scalar& distance) noexcept;
+int lowest_lane(const unsigned int& bits) noexcept;
+void reduce_lanes(
+    const float* values, const int* indices, const size_t& lanes, int& best,
+    float& distance) noexcept;
+
+Hull::Simd::Level Hull::Simd::detect_level() noexcept {
+#if defined(HULL_SIMD_X86) && defined(_MSC_VER)
+    // AVX2 needs the CPU flag and the OS saving the YMM registers
+    int info[4];
+    __cpuid(info, 1);
+    const auto osSavesYMM = (info[2] & (1 << 27)) != 0 &&
+                            (info[2] & (1 << 28)) != 0 &&
+                            (_xgetbv(0) & 6ULL) == 6ULL;
+    __cpuidex(info, 7, 0);
+    const auto osSavesZMM = osSavesYMM && (_xgetbv(0) & 0xE6ULL) == 0xE6ULL;
+    if (osSavesZMM && (info[1] & (1 << 16)) != 0)
+        return Level::AVX512;
+    if (osSavesYMM && (info[1] & (1 << 5)) != 0)
+        return Level::AVX2;
+    return Level::SSE2;
+#elif defined(HULL_SIMD_X86)
+    if (__builtin_cpu_supports("avx512f"))
+        return Level::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return Level::AVX2;
+    return Level::SSE2;
+#else
+    return Level::Scalar;
+#endif
+}
+
+#ifdef HULL_SIMD_X86
+// Test 4 points at a time, the SSE2 baseline of every x86-64 processor.
+void inside_planes_sse2(
+    const float* x, const float* y, const float* z, const size_t& count,
+    const float* planes, const size_t& planeCount,
+    unsigned char* inside) noexcept {
+    size_t i = 0ULL;
+    for (; i + 4ULL <= count; i += 4ULL) {
+        const auto px = _mm_loadu_ps(x + i);
+        const auto py = _mm_loadu_ps(y + i);
+        const auto pz = _mm_loadu_ps(z + i);
+        auto mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (size_t p = 0ULL; p < planeCount; ++p) {
+            const auto* plane = planes + p * 4ULL;
+            const auto distance = _mm_add_ps(
+                _mm_add_ps(
+                    _mm_mul_ps(px, _mm_set1_ps(plane[0])),
+                    _mm_mul_ps(py, _mm_set1_ps(plane[1]))),
+                _mm_mul_ps(pz, _mm_set1_ps(plane[2])));
+            mask = _mm_and_ps(
+                mask, _mm_cmplt_ps(distance, _mm_set1_ps(plane[3])));
+
+            // Stop once every lane is outside a plane
+            if (_mm_movemask_ps(mask) == 0)
+                break;
+        }
+        const auto bits = _mm_movemask_ps(mask);
+        for (size_t lane = 0ULL; lane < 4ULL; ++lane)
+            inside[i + lane] = static_cast<unsigned char>((bits >> lane) & 1);
+    }
+    inside_planes_scalar(x, y, z, i, count, planes, planeCount, inside);
+}
+
+// Test 8 points at a time.
+HULL_TARGET_AVX2 void inside_planes_avx2(
+    const float* x, const float* y, const float* z, const size_t& count,
+    const float* planes, const size_t& planeCount,
+    unsigned char* inside) noexcept {
+    size_t i = 0ULL;
+    for (; i + 8ULL <= count; i += 8ULL) {
+        const auto px = _mm256_loadu_ps(x + i);
+        const auto py = _mm256_loadu_ps(y + i);
+        const auto pz = _mm256_loadu_ps(z + i);
+        auto mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (size_t p = 0ULL; p < planeCount; ++p) {
+            const auto* plane = planes + p * 4ULL;
+            const auto distance = _mm256_add_ps(
+                _mm256_add_ps(
+                    _mm256_mul_ps(px, _mm256_set1_ps(plane[0])),
+                    _mm256_mul_ps(py, _mm256_set1_ps(plane[1]))),
+                _mm256_mul_ps(pz, _mm256_set1_ps(plane[2])));
+            mask = _mm256_and_ps(
+                mask,
+                _mm256_cmp_ps(distance, _mm256_set1_ps(plane[3]), _CMP_LT_OQ));
+
+            // Stop once every lane is outside a plane
+            if (_mm256_movemask_ps(mask) == 0)
+                break;
+        }
+        const auto bits = _mm256_movemask_ps(mask);
+        for (size_t lane = 0ULL; lane < 8ULL; ++lane)
+            inside[i + lane] = static_cast<unsigned char>((bits >> lane) & 1);
+    }
+    // Leave the wide registers clean before running legacy SSE code
+    _mm256_zeroupper();
+    inside_planes_scalar(x, y, z, i, count, planes, planeCount, inside);
+}
+#endif
+
+void Hull::Simd::inside_planes(
+    const float* x, const float* y, const float* z, const size_t& count,
+    const float* planes, const size_t& planeCount,
+    unsigned char* inside) noexcept {
+#ifdef HULL_SIMD_X86
+    static const auto level = detect_level();
+    if (level >= Level::AVX2)
+        return inside_planes_avx2(x, y, z, count, planes, planeCount, inside);
+    return inside_planes_sse2(x, y, z, count, planes, planeCount, inside);
+#else
+    inside_planes_scalar(x, y, z, 0ULL, count, planes, planeCount, inside);
+#endif
+}
+
+void Hull::Simd::inside_planes(
+    const double* x, const double* y, const double* z, const size_t& count,
+    const double* planes, const size_t& planeCount,
+    unsigned char* inside) noexcept {
+    inside_planes_scalar(x, y, z, 0ULL, count, planes, planeCount, inside);
+}
+
+// Test the points in [begin, count) one at a time, matching the rounding of
+// the vectorized kernels.
+template <typename Scalar>
+void inside_planes_scalar(
+    const Scalar* x, const Scalar* y, const Scalar* z, const size_t& begin,
+    const size_t& count, const Scalar* planes, const size_t& planeCount,
+    unsigned char* inside) noexcept {
+    for (auto i = begin; i < count; ++i) {
+        unsigned char mask = 1;
+        for (size_t p = 0ULL; p < planeCount && mask != 0; ++p) {
+            const auto* plane = planes + p * 4ULL;
+            const auto distance =
+                (x[i] * plane[0] + y[i] * plane[1]) + z[i] * plane[2];
+            if (!(distance < plane[3]))
+                mask = 0;
+        }
+        inside[i] = mask;
+    }
+}
+
+#ifdef HULL_SIMD_X86
+// Test a point against 4 planes at a time.
+int first_above_sse2(
+    const Hull::Simd::Planes& planes, const float& x, const float& y,
+    const float& z) noexcept {
+    const auto px = _mm_set1_ps(x);
+    const auto py = _mm_set1_ps(y);
+    const auto pz = _mm_set1_ps(z);
+    const auto padded = planes.offset.size();
+    for (size_t i = 0ULL; i < padded; i += 4ULL) {
+        const auto distance = _mm_add_ps(
+            _mm_add_ps(
+                _mm_mul_ps(px, _mm_loadu_ps(planes.x.data() + i)),
+                _mm_mul_ps(py, _mm_loadu_ps(planes.y.data() + i))),
+            _mm_mul_ps(pz, _mm_loadu_ps(planes.z.data() + i)));
+        const auto bits = static_cast<unsigned int>(_mm_movemask_ps(
+            _mm_cmpgt_ps(distance, _mm_loadu_ps(planes.offset.data() + i))));
+        if (bits != 0U)
+            return static_cast<int>(i) + lowest_lane(bits);
+    }
+    return -1;
+}
+
+// Test a point against 8 planes at a time.
+HULL_TARGET_AVX2 int first_above_avx2(
+    const Hull::Simd::Planes& planes, const float& x, const float& y,
+    const float& z) noexcept {
+    const auto px = _mm256_set1_ps(x);
+    const auto py = _mm256_set1_ps(y);
+    const auto pz = _mm256_set1_ps(z);
+    const auto padded = planes.offset.size();
+    for (size_t i = 0ULL; i < padded; i += 8ULL) {
+        const auto distance = _mm256_add_ps(
+            _mm256_add_ps(
+                _mm256_mul_ps(px, _mm256_loadu_ps(planes.x.data() + i)),
+                _mm256_mul_ps(py, _mm256_loadu_ps(planes.y.data() + i))),
+            _mm256_mul_ps(pz, _mm256_loadu_ps(planes.z.data() + i)));
+        const auto bits = static_cast<unsigned int>(
+            _mm256_movemask_ps(_mm256_cmp_ps(
+                distance, _mm256_loadu_ps(planes.offset.data() + i),
+                _CMP_GT_OQ)));
+        if (bits != 0U)
+            return static_cast<int>(i) + lowest_lane(bits);
+    }
+    return -1;
+}
+
+// Test a point against 16 planes at a time. AVX-512 brings fused
+// multiply-adds with it, the masked forms keep the compiler from fusing the
+// products so the rounding matches the other kernels.
+HULL_TARGET_AVX512 int first_above_avx512(
+    const Hull::Simd::Planes& planes, const float& x, const float& y,
+    const float& z) noexcept {
+    constexpr __mmask16 lanes(0xFFFF);
+    const auto px = _mm512_set1_ps(x);
+    const auto py = _mm512_set1_ps(y);
+    const auto pz = _mm512_set1_ps(z);
+    const auto padded = planes.offset.size();
+    for (size_t i = 0ULL; i < padded; i += 16ULL) {
+        const auto distance = _mm512_maskz_add_ps(
+            lanes,
+            _mm512_maskz_add_ps(
+                lanes,
+                _mm512_maskz_mul_ps(
+                    lanes, px, _mm512_loadu_ps(planes.x.data() + i)),
+                _mm512_maskz_mul_ps(
+                    lanes, py, _mm512_loadu_ps(planes.y.data() + i))),
+            _mm512_maskz_mul_ps(
+                lanes, pz, _mm512_loadu_ps(planes.z.data() + i)));
+        const auto bits = static_cast<unsigned int>(_mm512_cmp_ps_mask(
+            distance, _mm512_loadu_ps(planes.offset.data() + i), _CMP_GT_OQ));
+        if (bits != 0U)
+            return static_cast<int>(i) + lowest_lane(bits);
+    }
+    return -1;
+}
+
+// Track the farthest plane of each lane over 4 planes at a time.
+int farthest_above_sse2(
+    const Hull::Simd::Planes& planes, const float& x, const float& y,
+    const float& z, float& distance) noexcept {
+    const auto px = _mm_set1_ps(x);
+    const auto py = _mm_set1_ps(y);
+    const auto pz = _mm_set1_ps(z);
+    auto bestDistance = _mm_setzero_ps();
+    auto bestIndex = _mm_set1_epi32(-1);
+    auto index = _mm_setr_epi32(0, 1, 2, 3);
+    const auto padded = planes.offset.size();
+    for (size_t i = 0ULL; i < padded; i += 4ULL) {
+        const auto above = _mm_sub_ps(
+            _mm_add_ps(
+                _mm_add_ps(
+                    _mm_mul_ps(px, _mm_loadu_ps(planes.x.data() + i)),
+                    _mm_mul_ps(py, _mm_loadu_ps(planes.y.data() + i))),
+                _mm_mul_ps(pz, _mm_loadu_ps(planes.z.data() + i))),
+            _mm_loadu_ps(planes.offset.data() + i));
+        const auto farther = _mm_cmpgt_ps(above, bestDistance);
+        bestDistance = _mm_or_ps(
+            _mm_and_ps(farther, above), _mm_andnot_ps(farther, bestDistance));
+        bestIndex = _mm_or_si128(
+            _mm_and_si128(_mm_castps_si128(farther), index),
+            _mm_andnot_si128(_mm_castps_si128(farther), bestIndex));
+        index = _mm_add_epi32(index, _mm_set1_epi32(4));
+    }
+    float values[4];
+    int indices[4];
+    _mm_storeu_ps(values, bestDistance);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(indices), bestIndex);
+    auto best(-1);
+    distance = 0.0F;
+    reduce_lanes(values, indices, 4ULL, best, distance);
+    return best;
+}
+
+// Track the farthest plane of each lane over 8 planes at a time.
+HULL_TARGET_AVX2 int farthest_above_avx2(
+    const Hull::Simd::Planes& planes, const float& x, const float& y,
+    const float& z, float& distance) noexcept {
+    const auto px = _mm256_set1_ps(x);
+    const auto py = _mm256_set1_ps(y);
+    const auto pz = _mm256_set1_ps(z);
+    auto bestDistance = _mm256_setzero_ps();
+    auto bestIndex = _mm256_set1_epi32(-1);
+    auto index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const auto padded = planes.offset.size();
+    for (size_t i = 0ULL; i < padded; i += 8ULL) {
+        const auto above = _mm256_sub_ps(
+            _mm256_add_ps(
+                _mm256_add_ps(
+                    _mm256_mul_ps(px, _mm256_loadu_ps(planes.x.data() + i)),
+                    _mm256_mul_ps(py, _mm256_loadu_ps(planes.y.data() + i))),
+                _mm256_mul_ps(pz, _mm256_loadu_ps(planes.z.data() + i))),
+            _mm256_loadu_ps(planes.offset.data() + i));
+        const auto farther = _mm256_cmp_ps(above, bestDistance, _CMP_GT_OQ);
+        bestDistance = _mm256_blendv_ps(bestDistance, above, farther);
+        bestIndex = _mm256_castps_si256(_mm256_blendv_ps(
+            _mm256_castsi256_ps(bestIndex), _mm256_castsi256_ps(index),
+            farther));
+        index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+    }
+    float values[8];
+    int indices[8];
+    _mm256_storeu_ps(values, bestDistance);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices), bestIndex);
+    auto best(-1);
+    distance = 0.0F;
+    reduce_lanes(values, indices, 8ULL, best, distance);
+    return best;
+}
+
+// Track the farthest plane of each lane over 16 planes at a time.
+HULL_TARGET_AVX512 int farthest_above_avx512(
+    const Hull::Simd::Planes& planes, const float& x, const float& y,
+    const float& z, float& distance) noexcept {
+    constexpr __mmask16 lanes(0xFFFF);
+    const auto px = _mm512_set1_ps(x);
+    const auto py = _mm512_set1_ps(y);
+    const auto pz = _mm512_set1_ps(z);
+    auto bestDistance = _mm512_setzero_ps();
+    auto bestIndex = _mm512_set1_epi32(-1);
+    auto index = _mm512_setr_epi32(
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const auto padded = planes.offset.size();
+    for (size_t i = 0ULL; i < padded; i += 16ULL) {
+        const auto above = _mm512_maskz_sub_ps(
+            lanes,
+            _mm512_maskz_add_ps(
+                lanes,
+                _mm512_maskz_add_ps(
+                    lanes,
+                    _mm512_maskz_mul_ps(
+                        lanes, px, _mm512_loadu_ps(planes.x.data() + i)),
+                    _mm512_maskz_mul_ps(
+                        lanes, py, _mm512_loadu_ps(planes.y.data() + i))),
+                _mm512_maskz_mul_ps(
+                    lanes, pz, _mm512_loadu_ps(planes.z.data() + i))),
+            _mm512_loadu_ps(planes.offset.data() + i));
+        const auto farther =
+            _mm512_cmp_ps_mask(above, bestDistance, _CMP_GT_OQ);
+        bestDistance = _mm512_mask_mov_ps(bestDistance, farther, above);
+        bestIndex = _mm512_mask_mov_epi32(bestIndex, farther, index);
+        index = _mm512_add_epi32(index, _mm512_set1_epi32(16));
+    }
+    float values[16];
+    int indices[16];
+    _mm512_storeu_ps(values, bestDistance);
+    _mm512_storeu_si512(indices, bestIndex);
+    auto best(-1);
+    distance = 0.0F;
+    reduce_lanes(values, indices, 16ULL, best, distance);
+    return best;
+}
+#endif
+
+int Hull::Simd::first_above(
+    const Planes& planes, const float& x, const float& y,
+    const float& z) noexcept {
+#ifdef HULL_SIMD_X86
+    static const auto level = detect_level();
+    if (level == Level::AVX512)
+        return first_above_avx512(planes, x, y, z);
+    if (level == Level::AVX2)
+        return first_above_avx2(planes, x, y, z);
+    return first_above_sse2(planes, x, y, z);
+#else
+    return first_above_scalar(planes, x, y, z);
+#endif
+}
+
+int Hull::Simd::farthest_above(
+    const Planes& planes, const float& x, const float& y, const float& z,
+    float& distance) noexcept {
+#ifdef HULL_SIMD_X86
+    static const auto level = detect_level();
+    if (level == Level::AVX512)
+        return farthest_above_avx512(planes, x, y, z, distance);
+    if (level == Level::AVX2)
+        return farthest_above_avx2(planes, x, y, z, distance);
+    return farthest_above_sse2(planes, x, y, z, distance);
+#else
+    return farthest_above_scalar(planes, x, y, z, distance);
+#endif
+}
+
+int Hull::Simd::first_above(
+    const BasicPlanes<double>& planes, const double& x, const double& y,
+    const double& z) noexcept {
+    return first_above_scalar(planes, x, y, z);
+}
+
+int Hull::Simd::farthest_above(
+    const BasicPlanes<double>& planes, const double& x, const double& y,
+    const double& z, double& distance) noexcept {
+    return farthest_above_scalar(planes, x, y, z, distance);
+}
+
+// Test a point against the planes one at a time, matching the rounding of
+// the vectorized kernels.
+template <typename Scalar>
+int first_above_scalar(
+    const Hull::Simd::BasicPlanes<Scalar>& planes, const Scalar& x,
+    const Scalar& y, const Scalar& z) noexcept {
+    for (size_t i = 0ULL; i < planes.count; ++i)
+        if ((x * planes.x[i] + y * planes.y[i]) + z * planes.z[i] >
+            planes.offset[i])
+            return static_cast<int>(i);
+    return -1;
+}
+
+// Find the farthest plane one at a time, only taking planes strictly
+// farther than the best found so far.
+template <typename Scalar>
+int farthest_above_scalar(
+    const Hull::Simd::BasicPlanes<Scalar>& planes, const Scalar& x,
+    const Scalar& y, const Scalar& z, Scalar& distance) noexcept {
+    auto best(-1);
+    distance = Scalar(0);
+    for (size_t i = 0ULL; i < planes.count; ++i) {
+        const auto above =
+            ((x * planes.x[i] + y * planes.y[i]) + z * planes.z[i]) -
+            planes.offset[i];
+        if (above > distance) {
+            distance = above;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+// Find the lowest set bit of a lane mask.
+int lowest_lane(const unsigned int& bits) noexcept {
+    int lane(0);
+    while (((bits >> lane) & 1U) == 0U)
+        ++lane;
+    return lane;
+}
+
+// Merge the farthest plane found by each lane, breaking ties towards the
+// lowest index so the result matches a search one plane at a time.
+void reduce_lanes(
+    const float* values, const int* indices, const size_t& lanes, int& best,
+    float& distance) noexcept {
+    for (size_t lane = 0ULL; lane < lanes; ++lane) {
+        if (indices[lane] < 0)
+            continue;
+        if (values[lane] > distance ||
+            (values[lane] == distance && indices[lane] < best)) {
+            distance = values[lane];
+            best = indices[lane];
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/** Namespace encapsulating the vectorized kernels used by the hull. */
+namespace Hull::Simd {
+/** Instruction sets the kernels can be dispatched to. */
+enum class Level { Scalar, SSE2, AVX2, AVX512 };
+
+/** Facet planes kept as structure-of-arrays, so many can be tested at once.
+A point lies above plane 'i' when dot(normal, point) > offset[i]. The arrays
+are padded to a whole number of the widest kernel's lanes with planes that
+nothing lies above, so the kernels never need a scalar tail. */
+template <typename Scalar> struct BasicPlanes {
+    // Attributes
+    static constexpr size_t lanes = 16ULL; // the padding granularity.
+    std::vector<Scalar> x, y, z; // the normal of each plane.
+    std::vector<Scalar> offset;  // dot(normal, point) of a point on each.
+    size_t count = 0ULL;         // the number of planes before the padding.
+
+    // Methods
+    /** Remove every plane, keeping the storage for reuse. */
+    void clear() noexcept {
+        x.clear();
+        y.clear();
+        z.clear();
+        offset.clear();
+        count = 0ULL;
+    }
+    /** Add a plane to the end of the set.
+    @param  nx      the x component of the normal.
+    @param  ny      the y component of the normal.
+    @param  nz      the z component of the normal.
+    @param  d       the offset of the plane. */
+    void push_back(
+        const Scalar& nx, const Scalar& ny, const Scalar& nz,
+        const Scalar& d) {
+        if (count == offset.size()) {
+            const auto padded = count + lanes;
+            x.resize(padded, Scalar(0));
+            y.resize(padded, Scalar(0));
+            z.resize(padded, Scalar(0));
+            offset.resize(padded, std::numeric_limits<Scalar>::infinity());
+        }
+        x[count] = nx;
+        y[count] = ny;
+        z[count] = nz;
+        offset[count] = d;
+        ++count;
+    }
+    /** Retrieve the number of planes in the set.
+    @return the plane count, without the padding. */
+    size_t size() const noexcept { return count; }
+};
+/** The float planes the vectorized kernels run on. */
+using Planes = BasicPlanes<float>;
+
+/** Find the widest instruction set supported by this processor.
+@return the instruction set the kernels will use. */
+Level detect_level() noexcept;
+
+/** Flag the points lying strictly inside every one of a set of planes.
+@param  x           the x coordinate of each point.
+@param  y           the y coordinate of each point.
+@param  z           the z coordinate of each point.
+@param  count       the number of points.
+@param  planes      4 floats per plane, a normal followed by an offset, a
+                    point is inside when dot(normal, point) < offset.
+@param  planeCount  the number of planes.
+@param  inside      output flag per point, 1 if inside every plane. */
+void inside_planes(
+    const float* x, const float* y, const float* z, const size_t& count,
+    const float* planes, const size_t& planeCount,
+    unsigned char* inside) noexcept;
+/** Flag the points lying strictly inside every one of a set of planes, in
+double precision, one point at a time. */
+void inside_planes(
+    const double* x, const double* y, const double* z, const size_t& count,
+    const double* planes, const size_t& planeCount,
+    unsigned char* inside) noexcept;
+/** Find the first plane a point lies strictly above.
+@param  planes      the planes to test against.
+@param  x           the x coordinate of the point.
+@param  y           the y coordinate of the point.
+@param  z           the z coordinate of the point.
+@return the index of the first such plane, or -1 if there is none. */
+int first_above(
+    const Planes& planes, const float& x, const float& y,
+    const float& z) noexcept;
+/** Find the first plane a point lies strictly above, in double precision,
+one plane at a time. */
+int first_above(
+    const BasicPlanes<double>& planes, const double& x, const double& y,
+    const double& z) noexcept;
+/** Find the plane a point lies farthest above, scaled by each normal.
+@param  planes      the planes to test against.
+@param  x           the x coordinate of the point.
+@param  y           the y coordinate of the point.
+@param  z           the z coordinate of the point.
+@param  distance    output for how far above that plane the point lies.
+@return the index of the first such plane, or -1 if it is above none. */
+int farthest_above(
+    const Planes& planes, const float& x, const float& y, const float& z,
+    float& distance) noexcept;
+/** Find the plane a point lies farthest above, in double precision, one
+plane at a time. */
+int farthest_above(
+    const BasicPlanes<double>& planes, const double& x, const double& y,
+    const double& z, double& distance) noexcept;
+};     // namespace Hull::Simd
+#endif // SIMD_HPP
@@ -0,0 +1,222 @@
+#include "spatial.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+
+// Forward Declarations
+std::uint64_t spread_bits(std::uint64_t value) noexcept;
+size_t block_count(const size_t& count, Hull::ThreadPool* pool) noexcept;
+void run_blocks(
+    const size_t& blocks, Hull::ThreadPool* pool,
+    const std::function<void(size_t)>& job);
+
+// Number of keys below which sorting is not worth splitting across threads.
+constexpr size_t minimumBlockSize(16384ULL);
+// Number of bits sorted by each radix pass.
+constexpr unsigned int digitBits(8U);
+// Number of buckets of each radix pass.
+constexpr size_t bucketCount(1ULL << digitBits);
+
+template <typename Scalar, typename Index>
+void Hull::Spatial::morton_keys(
+    const BasicPointSpan<Scalar>& points, const std::vector<Index>& ids,
+    std::vector<std::uint64_t>& keys, ThreadPool* pool) {
+    // Find the bounding box of the points, a block at a time
+    const auto count = ids.size();
+    const auto blocks = block_count(count, pool);
+    constexpr auto lowest = std::numeric_limits<double>::lowest();
+    constexpr auto highest = std::numeric_limits<double>::max();
+    std::vector<std::array<double, 6>> blockBounds(
+        blocks, { highest, highest, highest, lowest, lowest, lowest });
+    run_blocks(blocks, pool, [&](const size_t& block) {
+        auto& bounds = blockBounds[block];
+        const auto last = count * (block + 1ULL) / blocks;
+        for (auto i = count * block / blocks; i < last; ++i) {
+            const auto* point = points[ids[i]].data();
+            for (size_t axis = 0ULL; axis < 3ULL; ++axis) {
+                bounds[axis] = std::min<double>(bounds[axis], point[axis]);
+                bounds[axis + 3ULL] =
+                    std::max<double>(bounds[axis + 3ULL], point[axis]);
+            }
+        }
+    });
+    auto bounds(blockBounds.front());
+    for (const auto& other : blockBounds) {
+        for (size_t axis = 0ULL; axis < 3ULL; ++axis) {
+            bounds[axis] = std::min(bounds[axis], other[axis]);
+            bounds[axis + 3ULL] =
+                std::max(bounds[axis + 3ULL], other[axis + 3ULL]);
+        }
+    }
+
+    // Quantize each point onto the grid and interleave its cell's bits
+    constexpr auto maxCell = static_cast<double>((1U << mortonBits) - 1U);
+    std::array<double, 3> scale{};
+    for (size_t axis = 0ULL; axis < 3ULL; ++axis) {
+        const auto extent = bounds[axis + 3ULL] - bounds[axis];
+        scale[axis] = extent > 0.0 ? maxCell / extent : 0.0;
+    }
+    keys.resize(count);
+    run_blocks(blocks, pool, [&](const size_t& block) {
+        const auto last = count * (block + 1ULL) / blocks;
+        for (auto i = count * block / blocks; i < last; ++i) {
+            const auto* point = points[ids[i]].data();
+            std::uint64_t key(0ULL);
+            for (size_t axis = 0ULL; axis < 3ULL; ++axis) {
+                const auto cell = std::clamp(
+                    (static_cast<double>(point[axis]) - bounds[axis]) *
+                        scale[axis],
+                    0.0, maxCell);
+                key |= spread_bits(static_cast<std::uint64_t>(cell)) << axis;
+            }
+            keys[i] = key;
+        }
+    });
+}
+
+template <typename Index>
+void Hull::Spatial::radix_sort(
+    std::vector<std::uint64_t>& keys, std::vector<Index>& ids,
+    ThreadPool* pool) {
+    const auto count = ids.size();
+    const auto blocks = block_count(count, pool);
+    std::vector<std::uint64_t> sortedKeys(count);
+    std::vector<Index> sortedIDs(count);
+    std::vector<std::array<size_t, bucketCount>> offsets(blocks);
+    for (unsigned int shift = 0U; shift < 64U; shift += digitBits) {
+        // Count the digits in each block
+        run_blocks(blocks, pool, [&](const size_t& block) {
+            auto& histogram = offsets[block];
+            histogram.fill(0ULL);
+            const auto last = count * (block + 1ULL) / blocks;
+            for (auto i = count * block / blocks; i < last; ++i)
+                ++histogram[(keys[i] >> shift) & (bucketCount - 1ULL)];
+        });
+
+        // Skip the pass if every key shares this digit, otherwise find
+        // where each block starts writing each digit, blocks in order.
+        size_t total(0ULL);
+        auto sharedDigit(false);
+        for (size_t digit = 0ULL; digit < bucketCount; ++digit) {
+            size_t digitTotal(0ULL);
+            for (auto& histogram : offsets) {
+                const auto digitCount = histogram[digit];
+                histogram[digit] = total;
+                total += digitCount;
+                digitTotal += digitCount;
+            }
+            sharedDigit = sharedDigit || digitTotal == count;
+        }
+        if (sharedDigit)
+            continue;
+
+        // Scatter each block, keeping keys with equal digits in order
+        run_blocks(blocks, pool, [&](const size_t& block) {
+            auto& offset = offsets[block];
+            const auto last = count * (block + 1ULL) / blocks;
+            for (auto i = count * block / blocks; i < last; ++i) {
+                const auto target =
+                    offset[(keys[i] >> shift) & (bucketCount - 1ULL)]++;
+                sortedKeys[target] = keys[i];
+                sortedIDs[target] = ids[i];
+            }
+        });
+        keys.swap(sortedKeys);
+        ids.swap(sortedIDs);
+    }
+}
+
+template <typename Scalar, typename Index>
+void Hull::Spatial::morton_order(
+    const BasicPointSpan<Scalar>& points, std::vector<Index>& ids,
+    ThreadPool* pool) {
+    std::vector<std::uint64_t> keys;
+    morton_keys(points, ids, keys, pool);
+    radix_sort(keys, ids, pool);
+}
+
+template <typename Index>
+void Hull::Spatial::biased_order(
+    std::vector<Index>& ids, const unsigned int& seed) {
+    // A round is picked by counting the trailing zeros of a random number,
+    // the rarest rounds going first.
+    constexpr size_t roundCount(32ULL);
+    std::mt19937 generator(seed);
+    std::vector<unsigned char> rounds(ids.size());
+    std::array<size_t, roundCount> offsets{};
+    for (auto& round : rounds) {
+        auto bits = static_cast<std::uint32_t>(generator());
+        round = 0U;
+        while (round + 1U < roundCount && (bits & 1U) == 0U) {
+            bits >>= 1U;
+            ++round;
+        }
+        ++offsets[round];
+    }
+    size_t total(0ULL);
+    for (auto round = roundCount; round-- > 0ULL;) {
+        const auto roundSize = offsets[round];
+        offsets[round] = total;
+        total += roundSize;
+    }
+    std::vector<Index> ordered(ids.size());
+    for (size_t i = 0ULL; i < ids.size(); ++i)
+        ordered[offsets[rounds[i]]++] = ids[i];
+    ids.swap(ordered);
+}
+
+// Spread the low 21 bits of a value out to every third bit.
+std::uint64_t spread_bits(std::uint64_t value) noexcept {
+    value &= 0x1FFFFFULL;
+    value = (value | value << 32U) & 0x1F00000000FFFFULL;
+    value = (value | value << 16U) & 0x1F0000FF0000FFULL;
+    value = (value | value << 8U) & 0x100F00F00F00F00FULL;
+    value = (value | value << 4U) & 0x10C30C30C30C30C3ULL;
+    value = (value | value << 2U) & 0x1249249249249249ULL;
+    return value;
+}
+
+// Find how many blocks to split some keys into, one per thread of the pool
+// unless there are too few keys for that to pay off.
+size_t block_count(const size_t& count, Hull::ThreadPool* pool) noexcept {
+    if (pool == nullptr)
+        return 1ULL;
+    return std::clamp<size_t>(count / minimumBlockSize, 1ULL, pool->size());
+}
+
+// Run a job for every block, across the pool if there is more than one.
+void run_blocks(
+    const size_t& blocks, Hull::ThreadPool* pool,
+    const std::function<void(size_t)>& job) {
+    if (pool == nullptr || blocks < 2ULL) {
+        for (size_t block = 0ULL; block < blocks; ++block)
+            job(block);
+        return;
+    }
+    pool->run(blocks, job);
+}
+
+// Explicit Instantiations
+template void Hull::Spatial::radix_sort(
+    std::vector<std::uint64_t>& keys, std::vector<std::int32_t>& ids,
+    ThreadPool* pool);
+template void Hull::Spatial::radix_sort(
+    std::vector<std::uint64_t>& keys, std::vector<std::int64_t>& ids,
+    ThreadPool* pool);
+template void Hull::Spatial::biased_order(
+    std::vector<std::int32_t>& ids, const unsigned int& seed);
+template void Hull::Spatial::biased_order(
+    std::vector<std::int64_t>& ids, const unsigned int& seed);
+#define INSTANTIATE_SPATIAL(Scalar, Index)                                     \
+    template void Hull::Spatial::morton_keys(                                  \
+        const BasicPointSpan<Scalar>& points, const std::vector<Index>& ids,   \
+        std::vector<std::uint64_t>& keys, ThreadPool* pool);                   \
+    template void Hull::Spatial::morton_order(                                 \
+        const BasicPointSpan<Scalar>& points, std::vector<Index>& ids,         \
+        ThreadPool* pool);
+INSTANTIATE_SPATIAL(float, std::int32_t);
+INSTANTIATE_SPATIAL(float, std::int64_t);
+INSTANTIATE_SPATIAL(double, std::int32_t);
+INSTANTIATE_SPATIAL(double, std::int64_t);
+#undef INSTANTIATE_SPATIAL
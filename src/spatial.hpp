@@ -0,0 +1,55 @@
+#ifndef SPATIAL_HPP
+#define SPATIAL_HPP
+
+#include "hull.hpp"
+#include "threadPool.hpp"
+#include <cstdint>
+#include <vector>
+
+/** Namespace encapsulating the spatial sorts used to order hull insertions.
+Each is explicitly instantiated for float and double points, and for 32 and
+64-bit indices. */
+namespace Hull::Spatial {
+/** Number of bits of each coordinate kept in a Morton key. */
+constexpr unsigned int mortonBits = 21U;
+
+/** Find the Morton key of some points, interleaving the bits of the cell
+each one falls in on a grid of 2^21 cells per axis spanning their bounding
+box. Points close together along the resulting Z-order curve are close
+together in space.
+@param  points  the points to find keys for.
+@param  ids     the index of each point to use.
+@param  keys    output key for each id.
+@param  pool    optional pool to spread the work across. */
+template <typename Scalar, typename Index>
+void morton_keys(
+    const BasicPointSpan<Scalar>& points, const std::vector<Index>& ids,
+    std::vector<std::uint64_t>& keys, ThreadPool* pool);
+/** Sort ids by their keys with a stable least significant digit radix sort,
+8 bits per pass. Each pass counts and scatters a block of the keys per
+thread, and passes where every key shares its digit are skipped.
+@param  keys    the key of each id, sorted along with them.
+@param  ids     the ids to sort.
+@param  pool    optional pool to spread the work across. */
+template <typename Index>
+void radix_sort(
+    std::vector<std::uint64_t>& keys, std::vector<Index>& ids,
+    ThreadPool* pool);
+/** Sort the ids of some points along the Z-order curve over them.
+@param  points  the points the ids refer to.
+@param  ids     the ids to sort.
+@param  pool    optional pool to spread the work across. */
+template <typename Scalar, typename Index>
+void morton_order(
+    const BasicPointSpan<Scalar>& points, std::vector<Index>& ids,
+    ThreadPool* pool);
+/** Reorder ids into a biased randomized insertion order (BRIO). Each id
+lands in round 'r' from the end with probability 2^-(r+1), so every round is
+about twice the size of the one before it, and ids keep their relative
+order within a round.
+@param  ids     the ids to reorder.
+@param  seed    specific seed to use for picking the rounds. */
+template <typename Index>
+void biased_order(std::vector<Index>& ids, const unsigned int& seed);
+};     // namespace Hull::Spatial
+#endif // SPATIAL_HPP
@@ -0,0 +1,147 @@
+#include "stream.hpp"
+#include "mappedFile.hpp"
+#include "profile.hpp"
+#include "workspace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Forward Declarations
+Hull::Stats append_hull_vertices(
+    const Hull::PointSpan& points, Hull::Workspace& workspace,
+    const Hull::Options& options, std::vector<vec3>& vertices);
+void merge_stats(
+    Hull::Stats& stats, const Hull::Stats& build,
+    const size_t& heldBytes) noexcept;
+
+std::vector<vec3> Hull::stream_convex_hull(
+    const std::string& path, const StreamOptions& options, Stats* stats) {
+    const auto start = std::chrono::steady_clock::now();
+    MappedFile file(path);
+    if (!file.is_open() || options.stride < sizeof(vec3))
+        return {};
+    const auto bytes =
+        file.size() > options.offset ? file.size() - options.offset : 0ULL;
+    const auto total = std::min<size_t>(
+        options.count, bytes >= sizeof(vec3)
+                           ? (bytes - sizeof(vec3)) / options.stride + 1ULL
+                           : 0ULL);
+    const auto chunkPoints =
+        std::clamp<size_t>(options.chunkPoints, 1ULL, maxPoints<int>);
+
+    // Points stay aligned in the mapping unless the offset or stride
+    // misaligns them, in which case each chunk gets copied out
+    const auto aligned = options.offset % alignof(vec3) == 0ULL &&
+                         options.stride % alignof(vec3) == 0ULL;
+
+    Workspace workspace;
+    std::vector<vec3> candidates;
+    std::vector<vec3> merged;
+    std::vector<vec3> copy;
+    Stats streamStats;
+    StreamProgress progress;
+    progress.totalPoints = total;
+    for (size_t first = 0ULL; first < total; first += chunkPoints) {
+        const auto count = std::min<size_t>(chunkPoints, total - first);
+        const auto length = (count - 1ULL) * options.stride + sizeof(vec3);
+        const auto* chunkBytes =
+            file.map(options.offset + first * options.stride, length);
+        if (chunkBytes == nullptr)
+            return {};
+        PointSpan chunk{ reinterpret_cast<const vec3*>(chunkBytes), count,
+                         options.stride };
+        if (!aligned) {
+            copy.resize(count);
+            for (size_t i = 0ULL; i < count; ++i)
+                std::memcpy(
+                    &copy[i], chunkBytes + i * options.stride, sizeof(vec3));
+            chunk = PointSpan{ copy.data(), count };
+        }
+
+        // Add the chunk's hull vertices to the candidates, then keep only
+        // those still on the hull of the candidates
+        const auto chunkStats = append_hull_vertices(
+            chunk, workspace, options.hull, candidates);
+        file.unmap();
+        merged.swap(candidates);
+        candidates.clear();
+        const auto mergeStats = append_hull_vertices(
+            PointSpan{ merged.data(), merged.size() }, workspace, options.hull,
+            candidates);
+        const auto heldBytes =
+            (candidates.capacity() + merged.capacity() + copy.capacity()) *
+            sizeof(vec3);
+        merge_stats(streamStats, chunkStats, heldBytes + length);
+        merge_stats(streamStats, mergeStats, heldBytes);
+
+        // Report how far along the stream is
+        if (options.progress) {
+            const std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+            progress.pointsRead = first + count;
+            progress.candidates = candidates.size();
+            progress.seconds = elapsed.count();
+            progress.pointsPerSecond =
+                static_cast<double>(progress.pointsRead) /
+                std::max(progress.seconds, 1e-9);
+            options.progress(progress);
+        }
+    }
+
+    // Hull what is left of the candidates
+    Stats finalStats;
+    auto hull(generate_convex_hull(candidates, options.hull, &finalStats));
+    merge_stats(
+        streamStats, finalStats,
+        (candidates.capacity() + merged.capacity() + copy.capacity()) *
+            sizeof(vec3));
+    streamStats.culledPoints = total - candidates.size();
+    if (stats != nullptr)
+        *stats = streamStats;
+    return hull;
+}
+
+// Append the hull vertices of some points to a list. Points without a hull
+// all lie on a line, so only the two ends of it get appended, or the one
+// point if they are all the same. Returns the stats of the hull found.
+Hull::Stats append_hull_vertices(
+    const Hull::PointSpan& points, Hull::Workspace& workspace,
+    const Hull::Options& options, std::vector<vec3>& vertices) {
+    Hull::Stats stats;
+    const auto mesh(
+        Hull::generate_convex_mesh(points, workspace, options, &stats));
+    if (mesh.vertices.empty()) {
+        if (points.count == 0ULL)
+            return stats;
+        const auto origin = points[0];
+        auto line = vec3(0.0F);
+        for (size_t i = 1ULL; i < points.count && line == vec3(0.0F); ++i)
+            line = points[i] - origin;
+        auto first(origin);
+        auto last(origin);
+        for (size_t i = 1ULL; i < points.count; ++i) {
+            const auto point = points[i];
+            if (line.dot(point - first) < 0.0F)
+                first = point;
+            if (line.dot(point - last) > 0.0F)
+                last = point;
+        }
+        vertices.emplace_back(first);
+        if (!(last == first))
+            vertices.emplace_back(last);
+        return stats;
+    }
+    for (const auto& vertex : mesh.vertices)
+        vertices.emplace_back(points[static_cast<size_t>(vertex)]);
+    return stats;
+}
+
+// Fold the stats of one hull build into the stream's, along with the bytes
+// the stream held on to while it ran. Timings and counters add up.
+void merge_stats(
+    Hull::Stats& stats, const Hull::Stats& build,
+    const size_t& heldBytes) noexcept {
+    Hull::Profile::accumulate(stats, build);
+    stats.peakFacets = std::max(stats.peakFacets, build.peakFacets);
+    stats.peakBytes = std::max(stats.peakBytes, build.peakBytes + heldBytes);
+}
@@ -0,0 +1,46 @@
+#ifndef STREAM_HPP
+#define STREAM_HPP
+
+#include "hull.hpp"
+#include <functional>
+#include <string>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+/** How far a streamed hull has got, reported after each chunk. */
+struct StreamProgress {
+    // Attributes
+    size_t pointsRead = 0ULL;     // points hulled so far.
+    size_t totalPoints = 0ULL;    // points in the whole file.
+    size_t candidates = 0ULL;     // hull vertices kept so far.
+    double seconds = 0.0;         // time taken so far.
+    double pointsPerSecond = 0.0; // throughput so far.
+};
+
+/** Settings a hull is streamed from a file with. */
+struct StreamOptions {
+    // Attributes
+    size_t chunkPoints = 1ULL << 22U; // points mapped and hulled at a time.
+    size_t offset = 0ULL;             // bytes to skip, such as a header.
+    size_t stride = sizeof(vec3);     // bytes from a point to the next.
+    size_t count = SIZE_MAX;          // most points to read from the file.
+    Options hull;                     // the settings to hull chunks with.
+    std::function<void(const StreamProgress&)> progress; // optional report.
+};
+
+/** Generate the convex hull of the float points stored in a binary file,
+without ever holding all of them in memory. The file is mapped one chunk at
+a time, each chunk is hulled on its own and only its hull vertices are kept,
+merged into a running set of candidates. Memory use is bounded by the chunk
+size plus the hull size rather than by the size of the file.
+@param  path    the file holding 3 floats per point.
+@param  options the settings to stream the hull with.
+@param  stats   optional output for measurements taken during generation,
+                culledPoints counting the points dropped between chunks.
+@return a convex hull containing the input points, empty if the file could
+        not be read. */
+std::vector<vec3> stream_convex_hull(
+    const std::string& path, const StreamOptions& options = {},
+    Stats* stats = nullptr);
+};     // namespace Hull
+#endif // STREAM_HPP
@@ -0,0 +1,146 @@
+#include "threadPool.hpp"
+
+// The index of the thread running a job within its pool.
+thread_local size_t threadIndex(0ULL);
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Destructor
+//////////////////////////////////////////////////////////////////////
+
+Hull::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+Hull::ThreadPool::ThreadPool(const size_t& threadCount)
+    : m_shares(threadCount > 0ULL ? threadCount : 1ULL) {
+    for (size_t i = 1ULL; i < m_shares.size(); ++i)
+        m_workers.emplace_back(&ThreadPool::work, this, i);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// thread_index
+//////////////////////////////////////////////////////////////////////
+
+size_t Hull::ThreadPool::thread_index() noexcept { return threadIndex; }
+
+//////////////////////////////////////////////////////////////////////
+/// run
+//////////////////////////////////////////////////////////////////////
+
+void Hull::ThreadPool::run(
+    const size_t& count, const std::function<void(size_t)>& job) {
+    // Hand every thread an even share of the batch and wake the workers
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto threads = m_shares.size();
+        for (size_t i = 0ULL; i < threads; ++i) {
+            std::lock_guard<std::mutex> shareLock(m_shares[i].mutex);
+            m_shares[i].begin = count * i / threads;
+            m_shares[i].end = count * (i + 1ULL) / threads;
+        }
+        m_job = &job;
+        m_active = m_workers.size();
+        ++m_batch;
+    }
+    m_wake.notify_all();
+
+    // Help out, then wait for the workers to finish their last jobs
+    const auto callerIndex = threadIndex;
+    drain(0ULL);
+    threadIndex = callerIndex;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [&]() { return m_active == 0ULL; });
+    m_job = nullptr;
+
+    // Rethrow the first exception a job threw, once no thread runs any
+    if (m_error) {
+        const auto error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// work
+//////////////////////////////////////////////////////////////////////
+
+void Hull::ThreadPool::work(const size_t& self) {
+    size_t batch(0ULL);
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&]() { return m_stop || m_batch != batch; });
+            if (m_stop)
+                return;
+            batch = m_batch;
+        }
+        drain(self);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_active == 0ULL)
+            m_done.notify_all();
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// drain
+//////////////////////////////////////////////////////////////////////
+
+void Hull::ThreadPool::drain(const size_t& self) noexcept {
+    threadIndex = self;
+    auto& share = m_shares[self];
+    do {
+        while (true) {
+            size_t index(0ULL);
+            {
+                std::lock_guard<std::mutex> lock(share.mutex);
+                if (share.begin >= share.end)
+                    break;
+                index = share.begin++;
+            }
+            try {
+                (*m_job)(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_error)
+                    m_error = std::current_exception();
+            }
+        }
+    } while (steal(self));
+}
+
+//////////////////////////////////////////////////////////////////////
+/// steal
+//////////////////////////////////////////////////////////////////////
+
+bool Hull::ThreadPool::steal(const size_t& self) {
+    const auto threads = m_shares.size();
+    for (size_t offset = 1ULL; offset < threads; ++offset) {
+        auto& victim = m_shares[(self + offset) % threads];
+        size_t begin(0ULL);
+        size_t end(0ULL);
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin >= victim.end)
+                continue;
+            begin = victim.begin + (victim.end - victim.begin) / 2ULL;
+            end = victim.end;
+            victim.end = begin;
+        }
+        auto& share = m_shares[self];
+        std::lock_guard<std::mutex> lock(share.mutex);
+        share.begin = begin;
+        share.end = end;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+//////////////////////////////////////////////////////////////////////
+/// \class  ThreadPool
+/// \brief  A fixed set of worker threads that run batches of jobs, each
+///         thread working through its own share of a batch and stealing
+///         from the others once it runs out.
+class ThreadPool {
+    public:
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Stop and join every worker thread.
+    ~ThreadPool();
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a pool running jobs on a given number of threads.
+    /// \param  threadCount the number of threads, including the caller's.
+    explicit ThreadPool(const size_t& threadCount);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Default copy constructor.
+    ThreadPool(const ThreadPool& other) = delete;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Default copy-assignment operator.
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of threads running jobs.
+    /// \return the worker count plus the calling thread.
+    size_t size() const noexcept { return m_workers.size() + 1ULL; }
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve which of a pool's threads is running a job.
+    /// \return 0 for the calling thread, up to size() - 1 for the workers.
+    static size_t thread_index() noexcept;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Run a job for every index in [0, count), blocking until all
+    ///         of them are done. The calling thread takes part. If any
+    ///         job throws, the rest of the batch still runs, then the
+    ///         first exception thrown gets rethrown.
+    /// \param  count       the number of jobs to run.
+    /// \param  job         the job to run, given the index of each job.
+    void run(const size_t& count, const std::function<void(size_t)>& job);
+
+    private:
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Wait for batches and run their jobs until stopped.
+    /// \param  self        the index of this worker's thread.
+    void work(const size_t& self);
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Run jobs from this thread's share, then steal from others,
+    ///         until the batch has no jobs left. Keeps the first
+    ///         exception any job throws for run() to rethrow.
+    /// \param  self        the index of the running thread.
+    void drain(const size_t& self) noexcept;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Move the upper half of another thread's share to this one.
+    /// \param  self        the index of the running thread.
+    /// \return true if any jobs were stolen, false otherwise.
+    bool steal(const size_t& self);
+
+    //////////////////////////////////////////////////////////////////////
+    /// \struct Share
+    /// \brief  The range of jobs a thread still has to run.
+    struct Share {
+        std::mutex mutex;   ///< Guards the range.
+        size_t begin = 0ULL; ///< The next job to run.
+        size_t end = 0ULL;   ///< One past the last job to run.
+    };
+
+    std::vector<std::thread> m_workers;         ///< The worker threads.
+    std::vector<Share> m_shares;                ///< Each thread's jobs.
+    std::mutex m_mutex;                         ///< Guards the batch state.
+    std::condition_variable m_wake;             ///< Signals a new batch.
+    std::condition_variable m_done;             ///< Signals a batch ended.
+    const std::function<void(size_t)>* m_job{}; ///< The batch's job.
+    std::exception_ptr m_error;                 ///< First job exception.
+    size_t m_batch = 0ULL;                      ///< The batch number.
+    size_t m_active = 0ULL;                     ///< Workers in the batch.
+    bool m_stop = false;                        ///< Set to end the workers.
+};
+};     // namespace Hull
+#endif // THREADPOOL_HPP
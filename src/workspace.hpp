@@ -0,0 +1,56 @@
+#ifndef WORKSPACE_HPP
+#define WORKSPACE_HPP
+
+#include "hull.hpp"
+#include "simd.hpp"
+#include <vector>
+
+/** Namespace encapsulating all hull-related operations. */
+namespace Hull {
+/** Buffers a hull gets built in. Keeping a workspace between calls lets each
+hull reuse the storage grown by the ones before it, so that once it fits,
+building a hull allocates nothing but its output. A workspace holds a single
+hull at a time, so keep one per thread. */
+template <typename Scalar, typename Index> struct BasicWorkspace {
+    // Attributes
+    std::vector<Point<Scalar>> points; // sorted points given to the engine.
+    std::vector<Index> order;          // input index of each sorted point.
+    std::vector<BasicTriangle<Scalar, Index>> hull; // the facet pool.
+    std::vector<Index> freeSlots;         // retired facet slots to recycle.
+    std::vector<Index> xList;             // facets retired by the last point.
+    std::vector<Index> newList;           // facets made by the last point.
+    BasicEdgeMap<Index> edgeMap;          // edges of new facets to pair up.
+    std::vector<Index> facetPoints;       // first point filed under a facet.
+    std::vector<Index> nextPoint;         // next point under the same facet.
+    std::vector<Index> pointFacet;        // facet each point is filed under.
+    std::vector<Index> farthestPoint;     // farthest point above a facet.
+    std::vector<Scalar> farthestDistance; // how far above it that point is.
+    std::vector<Index> sequence;          // order points get inserted in.
+    std::vector<Index> facets;            // facets to test or expand next.
+    Simd::BasicPlanes<Scalar> planes;     // planes of the facets to test.
+    std::vector<Scalar> margins;          // rounding margin of each plane.
+    Stats stats;                          // recorded by the current build.
+
+    // Methods
+    /** Find how much memory the engine buffers hold, which is everything
+    but the sorted points and their order.
+    @return the bytes held by the engine buffers. */
+    size_t engine_bytes() const noexcept {
+        return hull.capacity() * sizeof(BasicTriangle<Scalar, Index>) +
+               edgeMap.edges.capacity() *
+                   sizeof(typename BasicEdgeMap<Index>::Edge) +
+               (freeSlots.capacity() + xList.capacity() +
+                newList.capacity() + facetPoints.capacity() +
+                nextPoint.capacity() + pointFacet.capacity() +
+                farthestPoint.capacity() + sequence.capacity() +
+                facets.capacity()) *
+                   sizeof(Index) +
+               (planes.offset.capacity() * 4ULL + margins.capacity() +
+                farthestDistance.capacity()) *
+                   sizeof(Scalar);
+    }
+};
+/** The workspace of float points with the compact 32-bit index. */
+using Workspace = BasicWorkspace<float, int>;
+};     // namespace Hull
+#endif // WORKSPACE_HPP
@@ -0,0 +1,453 @@
+#include "hull.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(_WIN32)
+#include <windows.h>
+// windows.h must come first
+#include <malloc.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+// Settings picked from the command line
+struct Settings {
+    size_t minCount = 1000ULL;
+    size_t maxCount = 1000000ULL;
+    size_t repeats = 3ULL;
+    size_t threads = 0ULL;
+    double tolerance = 0.1;
+    std::vector<std::string> distributions;
+    std::string outputPath;
+    std::string baselinePath;
+};
+
+// Measurements of one phase over one cloud
+struct Result {
+    std::string distribution;
+    size_t points = 0ULL;
+    std::string algorithm;
+    std::string phase;
+    double seconds = 0.0;
+    double pointsPerSecond = 0.0;
+    size_t faces = 0ULL;
+    size_t peakRssBytes = 0ULL;
+    size_t peakHullBytes = 0ULL;
+    size_t allocations = 0ULL;
+    size_t allocatedBytes = 0ULL;
+};
+
+// Forward Declarations
+void* allocate(const size_t& size, const size_t& alignment) noexcept;
+void release(void* memory, const size_t& alignment) noexcept;
+void* allocate_or_throw(const size_t& size, const size_t& alignment);
+bool parse_settings(const int& argc, char* argv[], Settings& settings);
+std::vector<vec3> generate_distribution(
+    const std::string& distribution, const size_t& count,
+    const unsigned int& seed);
+Result run_phase(
+    const std::vector<vec3>& points, const Hull::Options& options,
+    const std::string& phase, const size_t& repeats);
+void reset_peak_rss() noexcept;
+size_t peak_rss() noexcept;
+std::string to_json(const std::vector<Result>& results);
+std::string result_key(const Result& result);
+bool compare_baseline(
+    const std::vector<Result>& results, const std::string& baselinePath,
+    const double& tolerance);
+
+// Every distribution the benchmark can sweep over
+const std::vector<std::string> allDistributions{
+    "cube", "ball", "sphere", "gaussian", "clustered", "coplanar"
+};
+// Seed for every generated cloud, fixed so runs can be compared.
+constexpr auto cloudSeed(1234567890U);
+
+// Allocations made since the counters were last reset
+std::atomic<size_t> allocationCount(0ULL);
+std::atomic<size_t> allocationBytes(0ULL);
+
+// Count an allocation and hand out memory for it, aligned past the default
+// alignment when asked. Every replaced operator new allocates through here.
+void* allocate(const size_t& size, const size_t& alignment) noexcept {
+    allocationCount.fetch_add(1ULL, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    const auto bytes = size > 0ULL ? size : 1ULL;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        return std::malloc(bytes);
+#if defined(_WIN32)
+    return _aligned_malloc(bytes, alignment);
+#else
+    void* memory(nullptr);
+    return posix_memalign(&memory, alignment, bytes) == 0 ? memory : nullptr;
+#endif
+}
+// Release memory handed out by allocate(), given the same alignment. Every
+// replaced operator delete releases through here.
+void release(void* memory, const size_t& alignment) noexcept {
+#if defined(_WIN32)
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        _aligned_free(memory);
+        return;
+    }
+#else
+    static_cast<void>(alignment);
+#endif
+    std::free(memory);
+}
+// Allocate as operator new must, throwing rather than returning null.
+void* allocate_or_throw(const size_t& size, const size_t& alignment) {
+    if (auto* memory = allocate(size, alignment))
+        return memory;
+    throw std::bad_alloc();
+}
+
+// Replace every global allocation function, so none of them pairs the
+// standard library's allocation with this file's release or the reverse
+constexpr auto defaultAlignment(
+    static_cast<size_t>(__STDCPP_DEFAULT_NEW_ALIGNMENT__));
+void* operator new(size_t size) {
+    return allocate_or_throw(size, defaultAlignment);
+}
+void* operator new[](size_t size) {
+    return allocate_or_throw(size, defaultAlignment);
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, defaultAlignment);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, defaultAlignment);
+}
+void* operator new(
+    size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](
+    size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* memory) noexcept {
+    release(memory, defaultAlignment);
+}
+void operator delete[](void* memory) noexcept {
+    release(memory, defaultAlignment);
+}
+void operator delete(void* memory, size_t) noexcept {
+    release(memory, defaultAlignment);
+}
+void operator delete[](void* memory, size_t) noexcept {
+    release(memory, defaultAlignment);
+}
+void operator delete(void* memory, std::align_val_t alignment) noexcept {
+    release(memory, static_cast<size_t>(alignment));
+}
+void operator delete[](void* memory, std::align_val_t alignment) noexcept {
+    release(memory, static_cast<size_t>(alignment));
+}
+void operator delete(
+    void* memory, size_t, std::align_val_t alignment) noexcept {
+    release(memory, static_cast<size_t>(alignment));
+}
+void operator delete[](
+    void* memory, size_t, std::align_val_t alignment) noexcept {
+    release(memory, static_cast<size_t>(alignment));
+}
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    release(memory, defaultAlignment);
+}
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    release(memory, defaultAlignment);
+}
+void operator delete(
+    void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    release(memory, static_cast<size_t>(alignment));
+}
+void operator delete[](
+    void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    release(memory, static_cast<size_t>(alignment));
+}
+
+int main(int argc, char* argv[]) {
+    Settings settings;
+    if (!parse_settings(argc, argv, settings)) {
+        std::cerr
+            << "Usage: HullBench [--min N] [--max N] [--repeat N]\n"
+            << "\t[--threads N] [--distribution NAME]... [--out FILE]\n"
+            << "\t[--baseline FILE] [--tolerance FRACTION]\n"
+            << "Distributions: cube, ball, sphere, gaussian, clustered, "
+               "coplanar" << std::endl;
+        return 2;
+    }
+    if (settings.distributions.empty())
+        settings.distributions = allDistributions;
+
+    // Sweep every distribution by powers of 10, through both engines
+    std::vector<Result> results;
+    for (const auto& distribution : settings.distributions) {
+        for (auto count = settings.minCount; count <= settings.maxCount;
+             count *= 10ULL) {
+            const auto points(
+                generate_distribution(distribution, count, cloudSeed));
+            for (const auto& algorithm :
+                 { Hull::Algorithm::Incremental, Hull::Algorithm::QuickHull }) {
+                Hull::Options options;
+                options.algorithm = algorithm;
+                options.threads = settings.threads;
+                for (const auto& phase : { "hull", "mesh" }) {
+                    auto result(
+                        run_phase(points, options, phase, settings.repeats));
+                    result.distribution = distribution;
+                    result.algorithm = algorithm == Hull::Algorithm::Incremental
+                                           ? "incremental"
+                                           : "quickhull";
+                    std::cerr << result_key(result) << ": "
+                              << result.seconds * 1000.0 << " ms" << std::endl;
+                    results.emplace_back(result);
+                }
+            }
+        }
+    }
+
+    // Write the results, then check them against the baseline if given
+    const auto json(to_json(results));
+    if (settings.outputPath.empty())
+        std::cout << json;
+    else
+        std::ofstream(settings.outputPath) << json;
+    if (!settings.baselinePath.empty() &&
+        !compare_baseline(results, settings.baselinePath, settings.tolerance))
+        return 1;
+    return 0;
+}
+
+// Read the command line into the settings, false if it is malformed.
+bool parse_settings(const int& argc, char* argv[], Settings& settings) {
+    try {
+        for (auto i = 1; i < argc; ++i) {
+            const std::string flag(argv[i]);
+            if (i + 1 >= argc)
+                return false;
+            const std::string value(argv[++i]);
+            if (flag == "--min")
+                settings.minCount = std::stoull(value);
+            else if (flag == "--max")
+                settings.maxCount = std::stoull(value);
+            else if (flag == "--repeat")
+                settings.repeats = std::stoull(value);
+            else if (flag == "--threads")
+                settings.threads = std::stoull(value);
+            else if (flag == "--tolerance")
+                settings.tolerance = std::stod(value);
+            else if (flag == "--out")
+                settings.outputPath = value;
+            else if (flag == "--baseline")
+                settings.baselinePath = value;
+            else if (
+                flag == "--distribution" &&
+                std::find(
+                    allDistributions.cbegin(), allDistributions.cend(),
+                    value) != allDistributions.cend())
+                settings.distributions.emplace_back(value);
+            else
+                return false;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return settings.minCount > 0ULL && settings.repeats > 0ULL;
+}
+
+// Generate a cloud of points from one of the benchmark distributions, on
+// every thread. The sphere puts every point on the hull, while the coplanar
+// slab is a cube squashed to within float rounding of a plane.
+std::vector<vec3> generate_distribution(
+    const std::string& distribution, const size_t& count,
+    const unsigned int& seed) {
+    Hull::CloudOptions options;
+    options.threads = std::thread::hardware_concurrency();
+    if (distribution == "ball")
+        options.distribution = Hull::Distribution::Ball;
+    else if (distribution == "sphere")
+        options.distribution = Hull::Distribution::Sphere;
+    else if (distribution == "gaussian")
+        options.distribution = Hull::Distribution::Gaussian;
+    else if (distribution == "clustered")
+        options.distribution = Hull::Distribution::Clustered;
+    auto points(Hull::generate_point_cloud(count, seed, options));
+    if (distribution == "coplanar")
+        for (auto& point : points)
+            point.z() *= 1e-6F;
+    return points;
+}
+
+// Time building either the triangle soup or the indexed mesh of some points,
+// keeping the fastest of a few repeats. Memory is measured on the first.
+Result run_phase(
+    const std::vector<vec3>& points, const Hull::Options& options,
+    const std::string& phase, const size_t& repeats) {
+    Result result;
+    result.points = points.size();
+    result.phase = phase;
+    result.seconds = std::numeric_limits<double>::max();
+    for (size_t repeat = 0ULL; repeat < repeats; ++repeat) {
+        Hull::Stats stats;
+        reset_peak_rss();
+        allocationCount = 0ULL;
+        allocationBytes = 0ULL;
+        const auto start = std::chrono::steady_clock::now();
+        const auto faces =
+            phase == "hull"
+                ? Hull::generate_convex_hull(points, options, &stats).size() /
+                      3ULL
+                : Hull::generate_convex_mesh(points, options, &stats)
+                          .indices.size() /
+                      3ULL;
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (repeat == 0ULL) {
+            result.faces = faces;
+            result.peakRssBytes = peak_rss();
+            result.peakHullBytes = stats.peakBytes;
+            result.allocations = allocationCount;
+            result.allocatedBytes = allocationBytes;
+        }
+        result.seconds = std::min(result.seconds, elapsed.count());
+    }
+    result.pointsPerSecond =
+        static_cast<double>(result.points) / std::max(result.seconds, 1e-9);
+    return result;
+}
+
+// Restart tracking the peak resident set size where the platform allows it,
+// elsewhere the peak covers the whole run so far.
+void reset_peak_rss() noexcept {
+#if defined(__linux__)
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+// Find the peak resident set size of the process in bytes.
+size_t peak_rss() noexcept {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return static_cast<size_t>(counters.PeakWorkingSetSize);
+    return 0ULL;
+#else
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.compare(0ULL, 6ULL, "VmHWM:") == 0)
+            return std::stoull(line.substr(6ULL)) * 1024ULL;
+#endif
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024ULL;
+#endif
+#endif
+}
+
+// Write the results as JSON, one result per line.
+std::string to_json(const std::vector<Result>& results) {
+    std::ostringstream json;
+    json.precision(9);
+    json << "{\n  \"benchmark\": \"HullBench\",\n  \"results\": [\n";
+    for (size_t i = 0ULL; i < results.size(); ++i) {
+        const auto& result = results[i];
+        json << "    { \"distribution\": \"" << result.distribution
+             << "\", \"points\": " << result.points << ", \"algorithm\": \""
+             << result.algorithm << "\", \"phase\": \"" << result.phase
+             << "\", \"seconds\": " << result.seconds
+             << ", \"pointsPerSecond\": " << result.pointsPerSecond
+             << ", \"faces\": " << result.faces
+             << ", \"peakRssBytes\": " << result.peakRssBytes
+             << ", \"peakHullBytes\": " << result.peakHullBytes
+             << ", \"allocations\": " << result.allocations
+             << ", \"allocatedBytes\": " << result.allocatedBytes << " }"
+             << (i + 1ULL < results.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+// Name a result by everything but its measurements.
+std::string result_key(const Result& result) {
+    return result.distribution + "/" + std::to_string(result.points) + "/" +
+           result.algorithm + "/" + result.phase;
+}
+
+// Compare the results against a file written by an earlier run, reporting
+// the change of each. Returns false if any got slower by more than the
+// tolerance.
+bool compare_baseline(
+    const std::vector<Result>& results, const std::string& baselinePath,
+    const double& tolerance) {
+    std::ifstream baseline(baselinePath);
+    if (!baseline) {
+        std::cerr << "Cannot read baseline " << baselinePath << std::endl;
+        return false;
+    }
+
+    // Each result sits on its own line, so read fields by name
+    const auto field = [](const std::string& line, const std::string& name) {
+        const auto start = line.find("\"" + name + "\": ");
+        if (start == std::string::npos)
+            return std::string();
+        auto first = start + name.size() + 4ULL;
+        if (line[first] == '"')
+            ++first;
+        const auto last = line.find_first_of("\",}", first);
+        return line.substr(first, last - first);
+    };
+    auto passed(true);
+    std::string line;
+    while (std::getline(baseline, line)) {
+        if (line.find("\"distribution\"") == std::string::npos)
+            continue;
+        Result previous;
+        previous.distribution = field(line, "distribution");
+        previous.points = std::stoull(field(line, "points"));
+        previous.algorithm = field(line, "algorithm");
+        previous.phase = field(line, "phase");
+        previous.seconds = std::stod(field(line, "seconds"));
+        const auto key(result_key(previous));
+        const auto current = std::find_if(
+            results.cbegin(), results.cend(),
+            [&key](const Result& result) { return result_key(result) == key; });
+        if (current == results.cend())
+            continue;
+        const auto change = current->seconds / previous.seconds - 1.0;
+        const auto regressed = change > tolerance;
+        passed = passed && !regressed;
+        std::cerr << (regressed ? "REGRESSED " : "ok        ") << key << ": "
+                  << previous.seconds * 1000.0 << " ms -> "
+                  << current->seconds * 1000.0 << " ms ("
+                  << (change >= 0.0 ? "+" : "") << change * 100.0 << "%)"
+                  << std::endl;
+    }
+    return passed;
+}
@@ -1,8 +1,30 @@
 #include "hull.hpp"
+#include "incrementalHull.hpp"
+#include "pointIO.hpp"
+#include "polytope.hpp"
+#include "predicates.hpp"
+#include "profile.hpp"
+#include "query.hpp"
+#include "random.hpp"
+#include "simd.hpp"
+#include "spatial.hpp"
+#include "stream.hpp"
+#include "threadPool.hpp"
+#include "workspace.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 //////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
@@ -14,7 +36,28 @@ constexpr auto pointCount(16384ULL);
 constexpr auto seed(1234567890U);
 
 void cloudTest(const std::vector<vec3>& pointCloud);
+void distributionTest();
 void hullTest(const std::vector<vec3>& pointCloud);
+void meshTest(
+    const std::vector<vec3>& pointCloud, const Hull::Options& options);
+void prefilterTest(const std::vector<vec3>& pointCloud);
+void threadTest(const std::vector<vec3>& pointCloud);
+void batchTest(const std::vector<vec3>& pointCloud);
+void incrementalTest(const std::vector<vec3>& pointCloud);
+void planesTest(const std::vector<vec3>& pointCloud);
+void degenerateTest();
+void precisionTest(const std::vector<vec3>& pointCloud);
+void orderTest(const std::vector<vec3>& pointCloud);
+void strideTest(const std::vector<vec3>& pointCloud);
+void workspaceTest(const std::vector<vec3>& pointCloud);
+void streamTest(const std::vector<vec3>& pointCloud);
+void ioTest(const std::vector<vec3>& pointCloud);
+void statsTest(const std::vector<vec3>& pointCloud);
+void sinkTest(const std::vector<vec3>& pointCloud);
+void warmTest(const std::vector<vec3>& pointCloud);
+void approximateTest(const std::vector<vec3>& pointCloud);
+void queryTest(const std::vector<vec3>& pointCloud);
+void polytopeTest(const std::vector<vec3>& pointCloud);
 
 int main() {
     // Generate a point cloud given the above variables
@@ -27,9 +70,74 @@ int main() {
     // Test the point cloud for accuracy
     cloudTest(pointCloud);
 
+    // Test the parallel point cloud generator
+    distributionTest();
+
     // Test the convex hull for accuracy
     hullTest(pointCloud);
 
+    // Test the indexed convex hull of every engine for accuracy
+    for (const auto& algorithm :
+         { Hull::Algorithm::Incremental, Hull::Algorithm::QuickHull }) {
+        Hull::Options options;
+        options.algorithm = algorithm;
+        meshTest(pointCloud, options);
+    }
+
+    // Test the interior point pre-filter
+    prefilterTest(pointCloud);
+
+    // Test the multi-threaded slab engine
+    threadTest(pointCloud);
+
+    // Test generating many small hulls at once
+    batchTest(pointCloud);
+
+    // Test growing a hull a few points at a time
+    incrementalTest(pointCloud);
+
+    // Test the vectorized facet plane kernels
+    planesTest(pointCloud);
+
+    // Test points that are mostly coplanar, collinear or repeated
+    degenerateTest();
+
+    // Test double coordinates far from the origin with 64-bit indices
+    precisionTest(pointCloud);
+
+    // Test inserting points along a space filling curve
+    orderTest(pointCloud);
+
+    // Test hulls over points interleaved with other data
+    strideTest(pointCloud);
+
+    // Test reusing the same buffers across many hulls
+    workspaceTest(pointCloud);
+
+    // Test streaming a hull from a file a chunk at a time
+    streamTest(pointCloud);
+
+    // Test reading points from and writing hulls to files
+    ioTest(pointCloud);
+
+    // Test the phase timings and counters recorded while hulling
+    statsTest(pointCloud);
+
+    // Test handing hull faces to a callback as they are found
+    sinkTest(pointCloud);
+
+    // Test warm starting a hull from the vertices of the previous frame
+    warmTest(pointCloud);
+
+    // Test approximating a hull within a face budget
+    approximateTest(pointCloud);
+
+    // Test finding which points lie inside a hull
+    queryTest(pointCloud);
+
+    // Test support queries and distances between hulls
+    polytopeTest(pointCloud);
+
     exit(0);
 }
 
@@ -63,11 +171,1241 @@ void cloudTest(const std::vector<vec3>& pointCloud) {
         pointCloud[0].z() == 1.83247185F);
 }
 
+void distributionTest() {
+    // Ensure the generator matches the published known answers
+    assert(
+        (Hull::Philox(0ULL)({ 0U, 0U, 0U, 0U }) ==
+         Hull::Philox::Block{ 0x6627E8D5U, 0xE169C58DU, 0xBC57AC4CU,
+                              0x9B00DBD8U }));
+    assert(
+        (Hull::Philox(~0ULL)({ ~0U, ~0U, ~0U, ~0U }) ==
+         Hull::Philox::Block{ 0x408F276DU, 0x41C83B0EU, 0xA20BC7C6U,
+                              0x6D5451FDU }));
+
+    for (const auto& distribution :
+         { Hull::Distribution::Cube, Hull::Distribution::Ball,
+           Hull::Distribution::Sphere, Hull::Distribution::Gaussian,
+           Hull::Distribution::Clustered }) {
+        Hull::CloudOptions options;
+        options.distribution = distribution;
+        options.scale = scale;
+        const auto cloud(
+            Hull::generate_point_cloud(pointCount * 8ULL, seed, options));
+
+        // Ensure the cloud is the same at any thread count, and that a
+        // smaller cloud is the start of a larger one
+        options.threads = 4ULL;
+        assert(
+            Hull::generate_point_cloud(pointCount * 8ULL, seed, options) ==
+            cloud);
+        [[maybe_unused]] const auto prefix(
+            Hull::generate_point_cloud(pointCount, seed, options));
+        assert(std::equal(prefix.cbegin(), prefix.cend(), cloud.cbegin()));
+
+        // Ensure every point lies within its shape
+        auto sum(0.0);
+        auto sumSquares(0.0);
+        for (const auto& point : cloud) {
+            [[maybe_unused]] const auto radius = std::sqrt(point.dot(point));
+            if (distribution == Hull::Distribution::Cube)
+                assert(
+                    std::abs(point.x()) <= scale &&
+                    std::abs(point.y()) <= scale &&
+                    std::abs(point.z()) <= scale);
+            else if (distribution == Hull::Distribution::Ball)
+                assert(radius <= scale * 1.0001F);
+            else if (distribution == Hull::Distribution::Sphere)
+                assert(std::abs(radius - scale) <= scale * 0.0001F);
+            sum += point.x();
+            sumSquares += static_cast<double>(point.x()) * point.x();
+        }
+
+        // Ensure a gaussian cloud has the requested deviation
+        [[maybe_unused]] const auto count = static_cast<double>(cloud.size());
+        [[maybe_unused]] const auto deviation =
+            std::sqrt(sumSquares / count - (sum / count) * (sum / count));
+        assert(
+            distribution != Hull::Distribution::Gaussian ||
+            std::abs(deviation - scale) < scale * 0.02);
+    }
+}
+
 void hullTest(const std::vector<vec3>& pointCloud) {
     // Attempt to generate a convex hull
+    Hull::Stats stats;
     [[maybe_unused]] const auto convexHull(
-        Hull::generate_convex_hull(pointCloud));
+        Hull::generate_convex_hull(pointCloud, {}, &stats));
 
     // Ensure we have actually have a hull
     assert(!convexHull.empty());
-}
\ No newline at end of file
+
+    // Ensure the facet pool recycled retired slots
+    assert(stats.peakFacets >= convexHull.size() / 3ULL);
+    assert(stats.peakFacets < pointCloud.size());
+    assert(stats.peakBytes > 0ULL);
+}
+
+void meshTest(
+    const std::vector<vec3>& pointCloud, const Hull::Options& options) {
+    // Attempt to generate an indexed convex hull
+    const auto mesh(Hull::generate_convex_mesh(pointCloud, options));
+    const auto faceCount = mesh.indices.size() / 3ULL;
+
+    // Ensure the mesh matches the triangle soup and is a closed surface
+    assert(
+        faceCount * 3ULL ==
+        Hull::generate_convex_hull(pointCloud, options).size());
+    assert(mesh.adjacency.size() == mesh.indices.size());
+    assert(faceCount == mesh.vertices.size() * 2ULL - 4ULL);
+
+    for (size_t face = 0ULL; face < faceCount; ++face) {
+        const auto& v0 = pointCloud[mesh.vertices[mesh.indices[face * 3ULL]]];
+        const auto& v1 =
+            pointCloud[mesh.vertices[mesh.indices[face * 3ULL + 1ULL]]];
+        const auto& v2 =
+            pointCloud[mesh.vertices[mesh.indices[face * 3ULL + 2ULL]]];
+
+        // Ensure every neighbour links back to this face
+        for (size_t edge = 0ULL; edge < 3ULL; ++edge) {
+            [[maybe_unused]] const auto neighbour =
+                static_cast<size_t>(mesh.adjacency[face * 3ULL + edge]);
+            assert(
+                mesh.adjacency[neighbour * 3ULL] == static_cast<int>(face) ||
+                mesh.adjacency[neighbour * 3ULL + 1ULL] ==
+                    static_cast<int>(face) ||
+                mesh.adjacency[neighbour * 3ULL + 2ULL] ==
+                    static_cast<int>(face));
+        }
+
+        // Ensure no point lies in front of a counter-clockwise face
+        [[maybe_unused]] const auto normal =
+            vec3::normalize((v1 - v0).cross(v2 - v0));
+        for ([[maybe_unused]] const auto& point : pointCloud)
+            assert((point - v0).dot(normal) < 1e-3F);
+    }
+
+    // Ensure every engine finds the same hull vertices
+    auto vertices(mesh.vertices);
+    auto expected(Hull::generate_convex_mesh(pointCloud).vertices);
+    std::sort(vertices.begin(), vertices.end());
+    std::sort(expected.begin(), expected.end());
+    assert(vertices == expected);
+}
+
+void prefilterTest(const std::vector<vec3>& pointCloud) {
+    // Attempt to generate a convex hull from pre-filtered points
+    Hull::Options options;
+    options.prefilter = true;
+    Hull::Stats stats;
+    const auto mesh(Hull::generate_convex_mesh(pointCloud, options, &stats));
+
+    // Ensure most of a uniform cloud got culled
+    assert(stats.culledPoints > pointCloud.size() / 2ULL);
+
+    // Ensure the hull still has the same vertices
+    auto vertices(mesh.vertices);
+    auto expected(Hull::generate_convex_mesh(pointCloud).vertices);
+    std::sort(vertices.begin(), vertices.end());
+    std::sort(expected.begin(), expected.end());
+    assert(vertices == expected);
+}
+
+void threadTest(const std::vector<vec3>& pointCloud) {
+    // Attempt to generate a convex hull on a single thread
+    Hull::Options options;
+    options.threads = 1ULL;
+    const auto expected(Hull::generate_convex_mesh(pointCloud, options));
+    assert(!expected.indices.empty());
+
+    // Ensure the same hull comes out regardless of the thread count
+    for (size_t threads = 2ULL; threads <= 5ULL; ++threads) {
+        options.threads = threads;
+        [[maybe_unused]] const auto mesh(
+            Hull::generate_convex_mesh(pointCloud, options));
+        assert(mesh.vertices == expected.vertices);
+        assert(mesh.indices == expected.indices);
+        assert(mesh.adjacency == expected.adjacency);
+    }
+
+    // Ensure it also matches the hull of the serial engine
+    auto vertices(expected.vertices);
+    auto serial(Hull::generate_convex_mesh(pointCloud).vertices);
+    std::sort(vertices.begin(), vertices.end());
+    std::sort(serial.begin(), serial.end());
+    assert(vertices == serial);
+
+    // Ensure a job throwing lets the rest of its batch run, then reaches
+    // the caller, leaving the pool usable
+    Hull::ThreadPool pool(4ULL);
+    std::atomic<size_t> finished(0ULL);
+    [[maybe_unused]] auto thrown(false);
+    try {
+        pool.run(256ULL, [&](const size_t& index) {
+            if (index % 64ULL == 7ULL)
+                throw std::runtime_error("job failed");
+            ++finished;
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && finished == 252ULL);
+    pool.run(256ULL, [&](const size_t&) { ++finished; });
+    assert(finished == 508ULL);
+}
+
+void batchTest(const std::vector<vec3>& pointCloud) {
+    // Split the point cloud into many small clouds of varying size
+    std::vector<Hull::PointSpan> clouds;
+    for (size_t first = 0ULL, size = 16ULL; first < pointCloud.size();
+         first += size, size = size % 1000ULL + 16ULL)
+        clouds.emplace_back(Hull::PointSpan{
+            pointCloud.data() + first,
+            std::min(size, pointCloud.size() - first) });
+
+    // Attempt to generate every hull at once
+    Hull::Options options;
+    options.threads = 3ULL;
+    const auto batch(Hull::generate_convex_hulls(clouds, options));
+    assert(batch.offsets.size() == clouds.size() + 1ULL);
+    assert(batch.offsets.back() == batch.vertices.size());
+
+    // Ensure each hull matches the one generated on its own
+    for (size_t cloud = 0ULL; cloud < clouds.size(); ++cloud) {
+        [[maybe_unused]] const auto expected(Hull::generate_convex_hull(
+            std::vector<vec3>(
+                clouds[cloud].data,
+                clouds[cloud].data + clouds[cloud].count)));
+        assert(
+            std::equal(
+                expected.cbegin(), expected.cend(),
+                batch.vertices.cbegin() + batch.offsets[cloud],
+                batch.vertices.cbegin() + batch.offsets[cloud + 1ULL]));
+    }
+}
+
+void incrementalTest(const std::vector<vec3>& pointCloud) {
+    // Ensure a hull is held back until the points span a volume
+    Hull::IncrementalHull hull;
+    hull.insert(
+        std::vector<vec3>(pointCloud.cbegin(), pointCloud.cbegin() + 3ULL));
+    assert(!hull.has_volume());
+    assert(hull.snapshot().indices.empty());
+
+    // Attempt to grow the hull in batches of varying size
+    for (size_t first = 3ULL, size = 1ULL; first < pointCloud.size();
+         first += size, size = size * 2ULL % 997ULL + 1ULL)
+        hull.insert(Hull::PointSpan{
+            pointCloud.data() + first,
+            std::min(size, pointCloud.size() - first) });
+    assert(hull.has_volume());
+    assert(hull.points().size() == pointCloud.size());
+
+    // Ensure the snapshot is a closed surface with every point behind it
+    const auto mesh(hull.snapshot());
+    const auto faceCount = mesh.indices.size() / 3ULL;
+    assert(faceCount == mesh.vertices.size() * 2ULL - 4ULL);
+    for (size_t face = 0ULL; face < faceCount; ++face) {
+        const auto& v0 = pointCloud[mesh.vertices[mesh.indices[face * 3ULL]]];
+        const auto& v1 =
+            pointCloud[mesh.vertices[mesh.indices[face * 3ULL + 1ULL]]];
+        const auto& v2 =
+            pointCloud[mesh.vertices[mesh.indices[face * 3ULL + 2ULL]]];
+        [[maybe_unused]] const auto normal =
+            vec3::normalize((v1 - v0).cross(v2 - v0));
+        for ([[maybe_unused]] const auto& point : pointCloud)
+            assert((point - v0).dot(normal) < 1e-3F);
+    }
+
+    // Ensure it has the same vertices as a hull built all at once
+    auto vertices(mesh.vertices);
+    auto expected(Hull::generate_convex_mesh(pointCloud).vertices);
+    std::sort(vertices.begin(), vertices.end());
+    std::sort(expected.begin(), expected.end());
+    assert(vertices == expected);
+
+    // Ensure points past what the index type can name get refused whole,
+    // leaving the hull as it was
+    [[maybe_unused]] const auto refused = hull.insert(Hull::PointSpan{
+        pointCloud.data(),
+        Hull::maxPoints<int> - pointCloud.size() + 1ULL });
+    assert(!refused && hull.points().size() == pointCloud.size());
+    assert(hull.snapshot().indices == mesh.indices);
+
+    // Ensure points passing just beside a vertex shared by many facets get
+    // added, each inserted on its own, leaving none above the hull
+    std::vector<vec3> cone{ vec3(0.0F, 0.0F, 1.0F), vec3(0.0F, 0.0F, -1.0F) };
+    for (size_t i = 0ULL; i < 127ULL; ++i) {
+        const auto angle = static_cast<float>(i) * 6.28318531F / 127.0F;
+        cone.emplace_back(std::cos(angle), std::sin(angle), 0.0F);
+    }
+    Hull::IncrementalHull coneHull;
+    coneHull.insert(cone);
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+    for (size_t i = 0ULL; i < 256ULL; ++i) {
+        const auto angle = unit(generator) * 6.28318531F;
+        const auto radius = unit(generator) * 1e-5F;
+        cone.emplace_back(
+            radius * std::cos(angle), radius * std::sin(angle),
+            1.0F + (unit(generator) + 0.2F) * 1e-6F);
+        coneHull.insert(std::vector<vec3>{ cone.back() });
+    }
+    const auto coneMesh(coneHull.snapshot());
+    for (size_t face = 0ULL; face < coneMesh.indices.size(); face += 3ULL) {
+        [[maybe_unused]] const auto& v0 =
+            cone[coneMesh.vertices[coneMesh.indices[face]]];
+        [[maybe_unused]] const auto& v1 =
+            cone[coneMesh.vertices[coneMesh.indices[face + 1ULL]]];
+        [[maybe_unused]] const auto& v2 =
+            cone[coneMesh.vertices[coneMesh.indices[face + 2ULL]]];
+        for ([[maybe_unused]] const auto& point : cone)
+            assert(Hull::Predicates::orient3d(v0, v1, v2, point) >= 0.0);
+    }
+
+    // Ensure a long flat start is held until a point leaves its plane,
+    // then leaves every point behind the hull
+    Hull::IncrementalHull flatHull;
+    std::vector<vec3> flat(pointCloud);
+    for (auto& point : flat) {
+        point.z() = 0.0F;
+        flatHull.insert(std::vector<vec3>{ point });
+    }
+    assert(!flatHull.has_volume());
+    flat.emplace_back(0.0F, 0.0F, scale);
+    flatHull.insert(std::vector<vec3>{ flat.back() });
+    assert(flatHull.has_volume());
+    const auto flatMesh(flatHull.snapshot());
+    assert(!flatMesh.indices.empty());
+    for (size_t face = 0ULL; face < flatMesh.indices.size(); face += 3ULL) {
+        [[maybe_unused]] const auto& v0 =
+            flat[flatMesh.vertices[flatMesh.indices[face]]];
+        [[maybe_unused]] const auto& v1 =
+            flat[flatMesh.vertices[flatMesh.indices[face + 1ULL]]];
+        [[maybe_unused]] const auto& v2 =
+            flat[flatMesh.vertices[flatMesh.indices[face + 2ULL]]];
+        for ([[maybe_unused]] const auto& point : flat)
+            assert(Hull::Predicates::orient3d(v0, v1, v2, point) >= 0.0);
+    }
+
+    // Ensure points interleaved with other data get read through the view,
+    // a few records at a time
+    struct Record {
+        vec3 position;
+        float intensity = 1e6F;
+    };
+    std::vector<Record> records;
+    for (size_t i = 0ULL; i < 200ULL; ++i)
+        records.emplace_back(Record{ pointCloud[i] });
+    Hull::IncrementalHull stridedHull;
+    for (size_t first = 0ULL; first < records.size(); first += 50ULL)
+        stridedHull.insert(Hull::PointSpan{
+            &records[first].position, 50ULL, sizeof(Record) });
+    assert(stridedHull.points().size() == records.size());
+    assert(std::equal(
+        stridedHull.points().cbegin(), stridedHull.points().cend(),
+        pointCloud.cbegin()));
+    const Hull::PointSpan view{ &records.front().position, records.size(),
+                                sizeof(Record) };
+    auto stridedVertices(stridedHull.snapshot().vertices);
+    auto stridedExpected(Hull::generate_convex_mesh(view).vertices);
+    std::sort(stridedVertices.begin(), stridedVertices.end());
+    std::sort(stridedExpected.begin(), stridedExpected.end());
+    assert(stridedVertices == stridedExpected);
+}
+
+void planesTest(const std::vector<vec3>& pointCloud) {
+    // Use the first few points as plane normals, at every partial width
+    for (size_t count = 0ULL; count <= 40ULL; ++count) {
+        Hull::Simd::Planes planes;
+        for (size_t p = 0ULL; p < count; ++p) {
+            const auto& normal = pointCloud[p];
+            planes.push_back(
+                normal.x(), normal.y(), normal.z(),
+                static_cast<float>(p % 7ULL) * 10.0F);
+        }
+        assert(planes.size() == count);
+
+        // Ensure each kernel matches a search one plane at a time
+        for (size_t i = count; i < count + 256ULL; ++i) {
+            const auto& point = pointCloud[i];
+            auto first(-1);
+            [[maybe_unused]] auto farthest(-1);
+            auto farthestDistance(0.0F);
+            for (size_t p = 0ULL; p < count; ++p) {
+                const auto distance =
+                    ((point.x() * planes.x[p] + point.y() * planes.y[p]) +
+                     point.z() * planes.z[p]) -
+                    planes.offset[p];
+                if (first < 0 && distance > 0.0F)
+                    first = static_cast<int>(p);
+                if (distance > farthestDistance) {
+                    farthestDistance = distance;
+                    farthest = static_cast<int>(p);
+                }
+            }
+            [[maybe_unused]] auto distance(0.0F);
+            assert(
+                Hull::Simd::first_above(
+                    planes, point.x(), point.y(), point.z()) == first);
+            assert(
+                Hull::Simd::farthest_above(
+                    planes, point.x(), point.y(), point.z(), distance) ==
+                farthest);
+            assert(farthest < 0 || distance == farthestDistance);
+        }
+    }
+}
+
+void degenerateTest() {
+    // Ensure the exact predicates agree with simple integer cases
+    using Hull::Predicates::orient2d;
+    using Hull::Predicates::orient3d;
+    assert(orient3d(vec3(0.0F), vec3(1.0F, 0.0F, 0.0F), vec3(0.0F, 1.0F, 0.0F),
+                    vec3(0.0F, 0.0F, -1.0F)) > 0.0);
+    assert(orient3d(vec3(0.0F), vec3(1.0F, 0.0F, 0.0F), vec3(0.0F, 1.0F, 0.0F),
+                    vec3(5.0F, 7.0F, 0.0F)) == 0.0);
+    assert(orient2d(vec3(0.0F), vec3(1.0F), vec3(3.0F), 0) == 0.0);
+    assert(orient2d(vec3(0.0F), vec3(0.0F, 1.0F, 0.0F), vec3(0.0F, 0.0F, 1.0F),
+                    0) > 0.0);
+
+    // Ensure a plane nudged by a single unit in the last place is told apart
+    [[maybe_unused]] const auto nudged = std::nextafter(1.0F, 2.0F);
+    const vec3 a(0.1F, 0.2F, 1.0F);
+    const vec3 b(0.7F, 0.3F, 1.0F);
+    const vec3 c(0.4F, 0.9F, 1.0F);
+    assert(orient3d(a, b, c, vec3(0.5F, 0.5F, 1.0F)) == 0.0);
+    assert(orient3d(a, b, c, vec3(0.5F, 0.5F, nudged)) < 0.0);
+
+    // Scatter points over the faces of a box on a coarse grid, so that they
+    // repeat and line up, and push some of them off their face by a hair.
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> grid(0, 20);
+    std::vector<vec3> boxCloud;
+    for (size_t i = 0ULL; i < 4000ULL; ++i) {
+        const auto face = generator() % 6U;
+        const auto u = static_cast<float>(grid(generator)) * 0.37F;
+        const auto v = static_cast<float>(grid(generator)) * 0.37F;
+        const auto w = (face & 1U) != 0U ? 7.4F : 0.0F;
+        auto point = face < 2U   ? vec3(w, u, v)
+                     : face < 4U ? vec3(u, w, v)
+                                 : vec3(u, v, w);
+        if (i % 3ULL == 0ULL)
+            point = point + vec3(static_cast<float>(generator() % 3U) * 1e-6F -
+                                     1e-6F,
+                                 0.0F, 0.0F);
+        boxCloud.emplace_back(point);
+    }
+
+    // Ensure every engine finds a closed hull with no point in front of it,
+    // including over the thin slabs the slab engine splits the box into
+    Hull::Options options;
+    for (size_t variant = 0ULL; variant < 12ULL; ++variant) {
+        options.algorithm = variant % 2ULL == 0ULL
+                                ? Hull::Algorithm::Incremental
+                                : Hull::Algorithm::QuickHull;
+        options.order =
+            static_cast<Hull::InsertionOrder>(variant / 2ULL % 3ULL);
+        options.threads = variant < 6ULL ? 0ULL : 4ULL;
+        const auto mesh(Hull::generate_convex_mesh(boxCloud, options));
+        const auto faceCount = mesh.indices.size() / 3ULL;
+        assert(faceCount > 0ULL);
+        assert(faceCount == mesh.vertices.size() * 2ULL - 4ULL);
+        for (size_t face = 0ULL; face < faceCount; ++face) {
+            [[maybe_unused]] const auto& v0 =
+                boxCloud[mesh.vertices[mesh.indices[face * 3ULL]]];
+            [[maybe_unused]] const auto& v1 =
+                boxCloud[mesh.vertices[mesh.indices[face * 3ULL + 1ULL]]];
+            [[maybe_unused]] const auto& v2 =
+                boxCloud[mesh.vertices[mesh.indices[face * 3ULL + 2ULL]]];
+            for ([[maybe_unused]] const auto& point : boxCloud)
+                assert(orient3d(v0, v1, v2, point) >= 0.0);
+        }
+    }
+}
+
+void precisionTest(const std::vector<vec3>& pointCloud) {
+    // Ensure the narrowest index is picked for the expected point count
+    static_assert(std::is_same_v<Hull::IndexFor<pointCount>, std::int32_t>);
+    static_assert(std::is_same_v<
+                  Hull::IndexFor<Hull::maxPoints<std::int32_t> + 1ULL>,
+                  std::int64_t>);
+
+    // Move the cloud far from the origin, where floats could no longer tell
+    // its points apart but doubles still hold every one of them exactly.
+    const Hull::Point<double> origin(4.5e6, 5.3e6, 1.2e3);
+    std::vector<Hull::Point<double>> farCloud;
+    farCloud.reserve(pointCloud.size());
+    for (const auto& point : pointCloud)
+        farCloud.emplace_back(
+            origin + Hull::Point<double>(point.x(), point.y(), point.z()));
+
+    // Ensure the moved cloud has exactly the same hull as the original
+    for (const auto& algorithm :
+         { Hull::Algorithm::Incremental, Hull::Algorithm::QuickHull }) {
+        Hull::Options options;
+        options.algorithm = algorithm;
+        const auto mesh(
+            Hull::generate_convex_mesh<std::int64_t>(farCloud, options));
+        const auto expected(Hull::generate_convex_mesh(pointCloud, options));
+        assert(mesh.indices.size() == expected.indices.size());
+        assert(
+            Hull::generate_convex_hull(farCloud, options).size() ==
+            mesh.indices.size());
+        std::vector<std::int64_t> vertices(mesh.vertices);
+        std::vector<std::int64_t> expectedVertices(
+            expected.vertices.cbegin(), expected.vertices.cend());
+        std::sort(vertices.begin(), vertices.end());
+        std::sort(expectedVertices.begin(), expectedVertices.end());
+        assert(vertices == expectedVertices);
+    }
+
+    // Ensure growing the moved hull finds the same vertices
+    Hull::BasicIncrementalHull<double, std::int64_t> hull;
+    hull.insert(farCloud);
+    assert(
+        hull.snapshot().vertices.size() ==
+        Hull::generate_convex_mesh(pointCloud).vertices.size());
+}
+
+void orderTest(const std::vector<vec3>& pointCloud) {
+    // Ensure the radix sort orders keys and keeps equal keys in place
+    std::vector<std::uint64_t> keys{ 5ULL, 1ULL << 40U, 5ULL, 0ULL, 3ULL };
+    std::vector<int> ids{ 0, 1, 2, 3, 4 };
+    Hull::Spatial::radix_sort(keys, ids, nullptr);
+    assert((ids == std::vector<int>{ 3, 4, 0, 2, 1 }));
+    assert(std::is_sorted(keys.cbegin(), keys.cend()));
+
+    // Ensure splitting the sort across threads gives the same result
+    std::mt19937_64 generator(seed);
+    std::vector<std::uint64_t> manyKeys(100000ULL);
+    for (auto& key : manyKeys)
+        key = generator() >> (generator() % 64U);
+    std::vector<std::int64_t> manyIDs(manyKeys.size());
+    std::iota(manyIDs.begin(), manyIDs.end(), 0LL);
+    auto expectedIDs(manyIDs);
+    std::stable_sort(
+        expectedIDs.begin(), expectedIDs.end(),
+        [&manyKeys](const std::int64_t& a, const std::int64_t& b) {
+            return manyKeys[a] < manyKeys[b];
+        });
+    Hull::ThreadPool pool(3ULL);
+    Hull::Spatial::radix_sort(manyKeys, manyIDs, &pool);
+    assert(manyIDs == expectedIDs);
+
+    // Ensure the biased order only shuffles the ids
+    std::vector<int> order(pointCloud.size());
+    std::iota(order.begin(), order.end(), 0);
+    Hull::Spatial::biased_order(order, seed);
+    assert(!std::is_sorted(order.cbegin(), order.cend()));
+    std::sort(order.begin(), order.end());
+    assert(order.front() == 0);
+    assert(order.back() == static_cast<int>(pointCloud.size()) - 1);
+    assert(std::adjacent_find(order.cbegin(), order.cend()) == order.cend());
+
+    // Ensure every engine finds the same hull in every order, serially and
+    // across the slab engine
+    for (const auto& insertion :
+         { Hull::InsertionOrder::Morton, Hull::InsertionOrder::Biased }) {
+        for (const auto& threads : { 0ULL, 3ULL }) {
+            for (const auto& algorithm :
+                 { Hull::Algorithm::Incremental, Hull::Algorithm::QuickHull }) {
+                Hull::Options options;
+                options.algorithm = algorithm;
+                options.order = insertion;
+                options.threads = threads;
+                meshTest(pointCloud, options);
+            }
+        }
+    }
+}
+
+void strideTest(const std::vector<vec3>& pointCloud) {
+    // Interleave the points with other data, as a scanner would record them
+    struct Record {
+        vec3 position;
+        float intensity;
+        double timestamp;
+    };
+    std::vector<Record> records;
+    records.reserve(pointCloud.size());
+    for (const auto& point : pointCloud)
+        records.emplace_back(Record{ point, point.z(), 0.0 });
+    const Hull::PointSpan view{ &records.front().position, records.size(),
+                                sizeof(Record) };
+
+    // Ensure the view gives exactly the same hulls as the packed points
+    for (const auto& prefilter : { false, true }) {
+        Hull::Options options;
+        options.prefilter = prefilter;
+        [[maybe_unused]] const auto mesh(
+            Hull::generate_convex_mesh(view, options));
+        [[maybe_unused]] const auto expected(
+            Hull::generate_convex_mesh(pointCloud, options));
+        assert(mesh.vertices == expected.vertices);
+        assert(mesh.indices == expected.indices);
+        assert(
+            Hull::generate_convex_hull(view, options) ==
+            Hull::generate_convex_hull(pointCloud, options));
+    }
+
+    // Ensure the batch engine reads through the view too
+    [[maybe_unused]] const auto batch(Hull::generate_convex_hulls({ view }));
+    assert(batch.vertices == Hull::generate_convex_hull(pointCloud));
+}
+
+void workspaceTest(const std::vector<vec3>& pointCloud) {
+    // Ensure hulls built in one workspace match fresh ones, whatever size
+    // of hull came before them
+    Hull::Workspace workspace;
+    const Hull::PointSpan view{ pointCloud.data(), pointCloud.size() };
+    const Hull::PointSpan half{ pointCloud.data(), pointCloud.size() / 2ULL };
+    for (const auto& algorithm :
+         { Hull::Algorithm::Incremental, Hull::Algorithm::QuickHull }) {
+        Hull::Options options;
+        options.algorithm = algorithm;
+        for (const auto& cloud : { view, half, view }) {
+            [[maybe_unused]] const auto mesh(
+                Hull::generate_convex_mesh(cloud, workspace, options));
+            [[maybe_unused]] const auto expected(
+                Hull::generate_convex_mesh(cloud, options));
+            assert(mesh.vertices == expected.vertices);
+            assert(mesh.indices == expected.indices);
+            assert(
+                Hull::generate_convex_hull(cloud, workspace, options) ==
+                Hull::generate_convex_hull(cloud, options));
+        }
+
+        // Ensure building the same hull again needs no more memory
+        [[maybe_unused]] const auto bytes = workspace.engine_bytes();
+        Hull::generate_convex_hull(view, workspace, options);
+        assert(workspace.engine_bytes() == bytes);
+    }
+}
+
+void streamTest(const std::vector<vec3>& pointCloud) {
+    // Find the sorted vertices of a triangle soup
+    const auto soupVertices = [](std::vector<vec3> soup) {
+        std::sort(soup.begin(), soup.end());
+        soup.erase(std::unique(soup.begin(), soup.end()), soup.end());
+        return soup;
+    };
+    const auto expected(soupVertices(Hull::generate_convex_hull(pointCloud)));
+
+    // Write the points packed into a file
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto path = (directory / "hullStreamTest.bin").string();
+    const auto write_points = [&](const size_t& header, const size_t& pad) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        const char zeros[8]{};
+        file.write(zeros, static_cast<std::streamsize>(header));
+        for (const auto& point : pointCloud) {
+            file.write(reinterpret_cast<const char*>(&point), sizeof(vec3));
+            file.write(zeros, static_cast<std::streamsize>(pad));
+        }
+    };
+    write_points(0ULL, 0ULL);
+
+    // Ensure the streamed hull matches the hull built in memory
+    Hull::StreamOptions options;
+    options.chunkPoints = 1000ULL;
+    size_t reports(0ULL);
+    options.progress =
+        [&reports]([[maybe_unused]] const Hull::StreamProgress& progress) {
+            ++reports;
+            assert(progress.pointsRead <= progress.totalPoints);
+            assert(progress.candidates > 0ULL);
+        };
+    Hull::Stats stats;
+    assert(
+        soupVertices(Hull::stream_convex_hull(path, options, &stats)) ==
+        expected);
+    assert(reports == (pointCloud.size() + 999ULL) / 1000ULL);
+    assert(stats.culledPoints > pointCloud.size() / 2ULL);
+    assert(stats.peakBytes > 0ULL);
+
+    // Ensure points behind a header and between other data are read, both
+    // when they stay aligned and when each chunk has to be copied out
+    options.progress = nullptr;
+    options.stride = sizeof(vec3) + 4ULL;
+    for (const auto& header : { 4ULL, 6ULL }) {
+        write_points(header, 4ULL);
+        options.offset = header;
+        assert(
+            soupVertices(Hull::stream_convex_hull(path, options)) ==
+            expected);
+    }
+
+    // Ensure points on a line only keep the ends of it as candidates
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        for (const auto& point : pointCloud) {
+            const vec3 onLine(point.x(), point.x() * 2.0F, -point.x());
+            file.write(reinterpret_cast<const char*>(&onLine), sizeof(vec3));
+        }
+    }
+    options = Hull::StreamOptions{};
+    options.chunkPoints = 1000ULL;
+    options.progress =
+        []([[maybe_unused]] const Hull::StreamProgress& progress) {
+            assert(progress.candidates == 2ULL);
+        };
+    assert(Hull::stream_convex_hull(path, options).empty());
+    std::filesystem::remove(path);
+
+    // Ensure a missing file gives no hull
+    assert(Hull::stream_convex_hull(path).empty());
+}
+
+void ioTest(const std::vector<vec3>& pointCloud) {
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto raw = (directory / "hullIoTest.bin").string();
+    const auto xyz = (directory / "hullIoTest.xyz").string();
+    const auto ply = (directory / "hullIoTest.ply").string();
+    const auto obj = (directory / "hullIoTest.obj").string();
+    assert(Hull::IO::format_of(raw) == Hull::IO::Format::Raw);
+    assert(Hull::IO::format_of("cloud.PTS") == Hull::IO::Format::XYZ);
+    assert(Hull::IO::format_of("cloud") == Hull::IO::Format::Auto);
+
+    // Ensure raw points read back exactly
+    std::vector<vec3> points;
+    {
+        std::ofstream file(raw, std::ios::binary | std::ios::trunc);
+        file.write(
+            reinterpret_cast<const char*>(pointCloud.data()),
+            static_cast<std::streamsize>(pointCloud.size() * sizeof(vec3)));
+    }
+    assert(Hull::IO::read_points(raw, points));
+    assert(points == pointCloud);
+
+    // Ensure text points read back in order across several parsing jobs,
+    // skipping comments and short lines and ignoring extra columns
+    constexpr size_t copies(8ULL);
+    {
+        std::ofstream file(xyz, std::ios::trunc);
+        file << "# x y z r\nnot a point\n";
+        std::array<char, 96> line{};
+        for (size_t copy = 0ULL; copy < copies; ++copy)
+            for (const auto& point : pointCloud) {
+                const auto length = std::snprintf(
+                    line.data(), line.size(), "%.9g, %.9g\t%.9g 1\r\n",
+                    static_cast<double>(point.x()),
+                    static_cast<double>(point.y()),
+                    static_cast<double>(point.z()));
+                file.write(line.data(), length);
+            }
+        file << "1 2";
+    }
+    Hull::ThreadPool pool(2ULL);
+    assert(Hull::IO::read_points(xyz, points, Hull::IO::Format::Auto, &pool));
+    assert(points.size() == copies * pointCloud.size());
+    for (size_t i = 0ULL; i < points.size(); ++i)
+        for (auto axis = 0; axis < 3; ++axis) {
+            [[maybe_unused]] const auto expected =
+                pointCloud[i % pointCloud.size()][axis];
+            assert(
+                std::abs(points[i][axis] - expected) <=
+                std::abs(expected) * std::numeric_limits<float>::epsilon());
+        }
+
+    // Ensure PLY vertices are found behind other elements and between
+    // other properties, then read and streamed in place
+    {
+        std::ofstream file(ply, std::ios::binary | std::ios::trunc);
+        file << "ply\nformat binary_little_endian 1.0\ncomment test\n"
+             << "element camera 1\nproperty int id\n"
+             << "element vertex " << pointCloud.size() << "\n"
+             << "property float x\nproperty float y\nproperty float z\n"
+             << "property uchar red\n"
+             << "element face 0\nproperty list uchar int vertex_indices\n"
+             << "end_header\n";
+        const char zeros[4]{};
+        file.write(zeros, 4);
+        for (const auto& point : pointCloud) {
+            file.write(reinterpret_cast<const char*>(&point), sizeof(vec3));
+            file.write(zeros, 1);
+        }
+    }
+    Hull::IO::PlyLayout layout;
+    assert(Hull::IO::read_ply_layout(ply, layout));
+    assert(layout.count == pointCloud.size());
+    assert(layout.stride == sizeof(vec3) + 1ULL);
+    assert(layout.packed && !layout.doubles);
+    assert(Hull::IO::read_points(ply, points, Hull::IO::Format::Auto, &pool));
+    assert(points == pointCloud);
+    Hull::StreamOptions streamOptions;
+    streamOptions.chunkPoints = 1000ULL;
+    streamOptions.offset = layout.offset;
+    streamOptions.stride = layout.stride;
+    streamOptions.count = layout.count;
+    Hull::Stats stats;
+    assert(!Hull::stream_convex_hull(ply, streamOptions, &stats).empty());
+    assert(stats.culledPoints > pointCloud.size() / 2ULL);
+
+    // Ensure a written mesh reads back as its hull vertices
+    const auto mesh(Hull::generate_convex_mesh(pointCloud));
+    assert(Hull::IO::write_mesh(ply, pointCloud, mesh));
+    assert(Hull::IO::read_ply_layout(ply, layout));
+    assert(
+        std::filesystem::file_size(ply) ==
+        layout.offset + mesh.vertices.size() * sizeof(vec3) +
+            mesh.indices.size() / 3ULL * 13ULL);
+    assert(Hull::IO::read_points(ply, points));
+    assert(points.size() == mesh.vertices.size());
+    for (size_t i = 0ULL; i < points.size(); ++i)
+        assert(points[i] == pointCloud[static_cast<size_t>(mesh.vertices[i])]);
+
+    // Ensure OBJ holds a line per vertex and per face, but is never read
+    assert(Hull::IO::write_mesh(obj, pointCloud, mesh));
+    {
+        std::ifstream file(obj);
+        std::string line;
+        size_t vertices(0ULL);
+        size_t faces(0ULL);
+        while (std::getline(file, line)) {
+            vertices += line.rfind("v ", 0ULL) == 0ULL ? 1ULL : 0ULL;
+            faces += line.rfind("f ", 0ULL) == 0ULL ? 1ULL : 0ULL;
+        }
+        assert(vertices == mesh.vertices.size());
+        assert(faces == mesh.indices.size() / 3ULL);
+    }
+    assert(!Hull::IO::read_points(obj, points));
+    assert(!Hull::IO::write_mesh(raw, pointCloud, mesh));
+    for (const auto& path : { raw, xyz, ply, obj })
+        std::filesystem::remove(path);
+
+    // Ensure a missing file is not read
+    assert(!Hull::IO::read_points(raw, points));
+}
+
+void statsTest(const std::vector<vec3>& pointCloud) {
+    // Ensure every point past the seed facets of each engine is either
+    // inserted or found interior, and the facet counts add up to the hull
+    for (const auto& [algorithm, seedPoints] :
+         { std::pair{ Hull::Algorithm::Incremental, 3ULL },
+           std::pair{ Hull::Algorithm::QuickHull, 4ULL } }) {
+        Hull::Options options;
+        options.algorithm = algorithm;
+        options.prefilter = true;
+        Hull::Stats stats;
+        [[maybe_unused]] const auto mesh(
+            Hull::generate_convex_mesh(pointCloud, options, &stats));
+        assert(stats.culledPoints > 0ULL && stats.peakFacets > 0ULL);
+        if constexpr (!Hull::Profile::enabled) {
+            assert(stats.facetsCreated == 0ULL && stats.insertNs == 0ULL);
+            continue;
+        }
+        assert(
+            stats.pointsInserted + stats.pointsInterior +
+                stats.coplanarPoints + seedPoints ==
+            pointCloud.size() - stats.culledPoints);
+        assert(stats.visibilityTests >= stats.pointsInterior);
+        assert(
+            stats.facetsCreated - stats.facetsRetired ==
+            mesh.indices.size() / 3ULL);
+        assert(stats.horizonEdges >= stats.maxHorizon);
+        assert(stats.maxHorizon >= 3ULL);
+        assert(stats.sortNs > 0ULL && stats.insertNs > 0ULL);
+    }
+
+    // Ensure a flat hull is built entirely on the coplanar path
+    std::vector<vec3> flat(pointCloud.cbegin(), pointCloud.cbegin() + 64);
+    for (auto& point : flat)
+        point.z() = 0.0F;
+    Hull::Stats stats;
+    [[maybe_unused]] const auto mesh(
+        Hull::generate_convex_mesh(flat, {}, &stats));
+    if constexpr (Hull::Profile::enabled) {
+        assert(stats.coplanarPoints > 0ULL);
+        assert(stats.pointsInserted == 0ULL);
+        assert(
+            stats.facetsCreated - stats.facetsRetired ==
+            mesh.indices.size() / 3ULL);
+    }
+
+    // Ensure the slab engine counts the work of every slab
+    Hull::Options options;
+    options.threads = 4ULL;
+    Hull::Stats slabStats;
+    Hull::generate_convex_hull(pointCloud, options, &slabStats);
+    if constexpr (Hull::Profile::enabled)
+        assert(
+            slabStats.pointsInserted + slabStats.pointsInterior >
+            pointCloud.size());
+}
+
+void sinkTest(const std::vector<vec3>& pointCloud) {
+    // Ensure the sink receives the triangle soup, face by face
+    const Hull::PointSpan span{ pointCloud.data(), pointCloud.size() };
+    std::vector<vec3> faces;
+    const Hull::FaceSink sink = [&faces](
+                                    const vec3& a, const vec3& b,
+                                    const vec3& c) {
+        faces.insert(faces.end(), { a, b, c });
+    };
+    Hull::Stats stats;
+    [[maybe_unused]] const auto faceCount =
+        Hull::generate_convex_hull(span, sink, {}, &stats);
+    assert(faceCount * 3ULL == faces.size());
+    assert(faces == Hull::generate_convex_hull(pointCloud));
+    assert(stats.peakFacets >= faceCount);
+
+    // Ensure every face is wound counter-clockwise seen from outside
+    for (size_t face = 0ULL; face < faces.size(); face += 3ULL) {
+        const auto& v0 = faces[face];
+        [[maybe_unused]] const auto normal = vec3::normalize(
+            (faces[face + 1ULL] - v0).cross(faces[face + 2ULL] - v0));
+        for ([[maybe_unused]] const auto& point : pointCloud)
+            assert((point - v0).dot(normal) < 1e-3F);
+    }
+
+    // Ensure a reused workspace delivers the same faces, and too few
+    // points deliver none
+    Hull::Workspace workspace;
+    faces.clear();
+    assert(
+        Hull::generate_convex_hull(span, workspace, sink) == faceCount &&
+        faces == Hull::generate_convex_hull(pointCloud));
+    assert(
+        Hull::generate_convex_hull(
+            Hull::PointSpan{ pointCloud.data(), 3ULL }, workspace, sink) ==
+        0ULL);
+}
+
+void warmTest(const std::vector<vec3>& pointCloud) {
+    // Move every point a little, as between two frames of an animation
+    std::vector<vec3> moved(pointCloud);
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> jitter(-0.01F, 0.01F);
+    for (auto& point : moved)
+        point = point + vec3(jitter(generator), jitter(generator),
+                             jitter(generator));
+    const Hull::PointSpan span{ moved.data(), moved.size() };
+    [[maybe_unused]] const auto sorted_vertices = [](const Hull::Mesh& mesh) {
+        auto vertices(mesh.vertices);
+        std::sort(vertices.begin(), vertices.end());
+        return vertices;
+    };
+
+    // Ensure seeding with the last frame's vertices finds the same hull as a
+    // cold start, with fewer points inserted along the way
+    const auto previous(Hull::generate_convex_mesh(pointCloud));
+    Hull::Workspace workspace;
+    Hull::Stats coldStats;
+    Hull::Stats warmStats;
+    const auto cold(
+        Hull::generate_convex_mesh(span, workspace, {}, &coldStats));
+    [[maybe_unused]] const auto warm(Hull::generate_convex_mesh(
+        span, previous.vertices, workspace, &warmStats));
+    assert(sorted_vertices(warm) == sorted_vertices(cold));
+    assert(warm.indices.size() == cold.indices.size());
+    assert(warm.adjacency.size() == warm.indices.size());
+    if constexpr (Hull::Profile::enabled)
+        assert(warmStats.pointsInserted <= coldStats.pointsInserted);
+    const auto corner = [&](const size_t& index) {
+        return moved[warm.vertices[warm.indices[index]]];
+    };
+    for (size_t face = 0ULL; face < warm.indices.size(); face += 3ULL) {
+        const auto v0 = corner(face);
+        [[maybe_unused]] const auto normal = vec3::normalize(
+            (corner(face + 1ULL) - v0).cross(corner(face + 2ULL) - v0));
+        for ([[maybe_unused]] const auto& point : moved)
+            assert((point - v0).dot(normal) < 1e-3F);
+    }
+
+    // Ensure stale, repeated, out of range or missing seeds still give the
+    // exact hull
+    const std::vector<std::vector<int>> badSeeds{
+        {}, { 0, 0, 0, 0 }, { -1, 7, 7, static_cast<int>(moved.size()) },
+        std::vector<int>(
+            previous.vertices.crbegin(), previous.vertices.crend()),
+        { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }
+    };
+    for ([[maybe_unused]] const auto& seeds : badSeeds)
+        assert(
+            sorted_vertices(Hull::generate_convex_mesh(
+                span, seeds, workspace)) == sorted_vertices(cold));
+
+    // Ensure too few points give no hull
+    assert(Hull::generate_convex_mesh(
+               Hull::PointSpan{ moved.data(), 3ULL }, previous.vertices,
+               workspace)
+               .indices.empty());
+}
+
+void approximateTest(const std::vector<vec3>& pointCloud) {
+    // Find the farthest any point lies above the plane of a face, which is
+    // at most its distance from the hull
+    [[maybe_unused]] const auto farthest_outside =
+        [&pointCloud](const std::vector<vec3>& hull) {
+            auto farthest(0.0F);
+            for (size_t face = 0ULL; face < hull.size(); face += 3ULL) {
+                const auto& v0 = hull[face];
+                const auto normal = vec3::normalize(
+                    (hull[face + 1ULL] - v0).cross(hull[face + 2ULL] - v0));
+                for (const auto& point : pointCloud)
+                    farthest = std::max(farthest, (point - v0).dot(normal));
+            }
+            return farthest;
+        };
+    [[maybe_unused]] const auto exact(Hull::generate_convex_hull(pointCloud));
+
+    // Ensure each face budget is kept, by faces of input points, and the
+    // error bounds how far the points lie outside
+    for (const auto& maxFaces : { 4ULL, 20ULL, 64ULL, 256ULL }) {
+        Hull::ApproximateOptions options;
+        options.maxFaces = maxFaces;
+        auto error(-1.0F);
+        [[maybe_unused]] const auto hull(
+            Hull::approximate_convex_hull(pointCloud, options, &error));
+        assert(!hull.empty() && hull.size() % 3ULL == 0ULL);
+        assert(hull.size() / 3ULL <= maxFaces);
+        assert(hull.size() < exact.size());
+        assert(error > 0.0F);
+        assert(farthest_outside(hull) <= error * 1.0001F);
+        for ([[maybe_unused]] const auto& vertex : hull)
+            assert(
+                std::find(pointCloud.cbegin(), pointCloud.cend(), vertex) !=
+                pointCloud.cend());
+    }
+
+    // Ensure a tolerance alone stops the refinement once it is met, and a
+    // tight one reaches the exact hull
+    Hull::ApproximateOptions options;
+    options.maxFaces = 0ULL;
+    options.epsilon = 0.5;
+    auto error(-1.0F);
+    [[maybe_unused]] const auto loose(
+        Hull::approximate_convex_hull(pointCloud, options, &error));
+    assert(error <= 0.5F && farthest_outside(loose) <= 0.5F);
+    assert(loose.size() < exact.size());
+    options.epsilon = 0.0;
+    [[maybe_unused]] const auto tight(
+        Hull::approximate_convex_hull(pointCloud, options, &error));
+    assert(farthest_outside(tight) <= 1e-4F);
+
+    // Ensure a conservative hull keeps the budget and holds every point
+    options.maxFaces = 64ULL;
+    options.conservative = true;
+    [[maybe_unused]] const auto conservative(
+        Hull::approximate_convex_hull(pointCloud, options, &error));
+    assert(!conservative.empty() && conservative.size() / 3ULL <= 64ULL);
+    assert(farthest_outside(conservative) <= 0.0F && error > 0.0F);
+
+    // Ensure flat points keep the budget too, their edges reaching every
+    // point once it allows, and too few points or a line get no hull
+    std::vector<vec3> flat(pointCloud.cbegin(), pointCloud.cbegin() + 64);
+    for (auto& point : flat)
+        point.z() = 1.0F;
+    for (const auto& maxFaces : { 4ULL, 8ULL, 0ULL }) {
+        Hull::ApproximateOptions flatOptions;
+        flatOptions.maxFaces = maxFaces;
+        [[maybe_unused]] const auto flatHull(
+            Hull::approximate_convex_hull(flat, flatOptions, &error));
+        assert(!flatHull.empty() && flatHull.size() % 3ULL == 0ULL);
+        assert(maxFaces == 0ULL || flatHull.size() / 3ULL <= maxFaces);
+        assert(maxFaces != 0ULL || error == 0.0F);
+        for ([[maybe_unused]] const auto& vertex : flatHull)
+            assert(vertex.z() == 1.0F);
+    }
+    assert(Hull::approximate_convex_hull(
+               std::vector<vec3>(pointCloud.cbegin(), pointCloud.cbegin() + 3))
+               .empty());
+    const std::vector<vec3> line{
+        { 0, 0, 0 }, { 1, 2, -1 }, { 2, 4, -2 }, { 3, 6, -3 }
+    };
+    assert(Hull::approximate_convex_hull(line).empty());
+}
+
+void queryTest(const std::vector<vec3>& pointCloud) {
+    // Scatter points in and around the cloud
+    std::vector<vec3> queries(20000ULL);
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> coordinate(
+        -scale * 1.5F, scale * 1.5F);
+    for (auto& point : queries)
+        point = vec3(
+            coordinate(generator), coordinate(generator),
+            coordinate(generator));
+    const Hull::PointSpan span{ queries.data(), queries.size() };
+
+    // Ensure every method agrees with testing each face plane, skipping
+    // the points too close to a plane to tell
+    Hull::CloudOptions sphere;
+    sphere.distribution = Hull::Distribution::Sphere;
+    sphere.scale = scale;
+    const auto sphereCloud(Hull::generate_point_cloud(4000ULL, seed, sphere));
+    Hull::ThreadPool pool(4ULL);
+    for (const auto* cloud : { &pointCloud, &sphereCloud }) {
+        const auto mesh(Hull::generate_convex_mesh(*cloud));
+        std::vector<unsigned char> expected(queries.size(), 1);
+        std::vector<unsigned char> unclear(queries.size(), 0);
+        for (size_t face = 0ULL; face < mesh.indices.size(); face += 3ULL) {
+            const auto& v0 = (*cloud)[mesh.vertices[mesh.indices[face]]];
+            const auto normal = vec3::normalize(
+                ((*cloud)[mesh.vertices[mesh.indices[face + 1ULL]]] - v0)
+                    .cross(
+                        (*cloud)[mesh.vertices[mesh.indices[face + 2ULL]]] -
+                        v0));
+            for (size_t i = 0ULL; i < queries.size(); ++i) {
+                const auto distance = (queries[i] - v0).dot(normal);
+                if (distance >= 0.0F)
+                    expected[i] = 0;
+                if (std::abs(distance) < 1e-3F)
+                    unclear[i] = 1;
+            }
+        }
+        for (const auto& method :
+             { Hull::QueryMethod::Planes, Hull::QueryMethod::Walk }) {
+            const Hull::Query query(*cloud, mesh, method);
+            assert(query.method() == method);
+            std::vector<unsigned char> inside;
+            std::vector<unsigned char> parallel;
+            query.contains(span, inside);
+            query.contains(span, parallel, &pool);
+            assert(inside == parallel);
+            for (size_t i = 0ULL; i < queries.size(); ++i) {
+                assert(unclear[i] != 0 || inside[i] == expected[i]);
+                assert(query.contains(queries[i]) == (inside[i] != 0));
+            }
+        }
+    }
+
+    // Ensure large hulls get walked and small ones get their planes tested
+    assert(
+        Hull::Query(sphereCloud, Hull::generate_convex_mesh(sphereCloud))
+            .method() == Hull::QueryMethod::Walk);
+    const std::vector<vec3> cube{ { -1, -1, -1 }, { 1, -1, -1 }, { -1, 1, -1 },
+                                  { 1, 1, -1 },   { -1, -1, 1 }, { 1, -1, 1 },
+                                  { -1, 1, 1 },   { 1, 1, 1 } };
+    const Hull::Query cubeQuery(cube, Hull::generate_convex_mesh(cube));
+    assert(cubeQuery.method() == Hull::QueryMethod::Planes);
+    assert(cubeQuery.contains(vec3(0.5F, -0.5F, 0.9F)));
+    assert(!cubeQuery.contains(vec3(0.5F, -1.5F, 0.9F)));
+
+    // Ensure a flat hull contains nothing
+    std::vector<vec3> flat(pointCloud.cbegin(), pointCloud.cbegin() + 64);
+    for (auto& point : flat)
+        point.z() = 0.0F;
+    const Hull::Query flatQuery(
+        flat, Hull::generate_convex_mesh(flat), Hull::QueryMethod::Walk);
+    assert(flatQuery.method() == Hull::QueryMethod::Planes);
+    assert(!flatQuery.contains(vec3(0.0F)));
+
+    // Ensure hulls with no faces, of points on a line or too few points,
+    // contain nothing either
+    const std::vector<vec3> line{ { 0, 0, 0 }, { 1, 0, 0 }, { 2, 0, 0 } };
+    const std::vector<vec3> triangle(
+        pointCloud.cbegin(), pointCloud.cbegin() + 3);
+    for (const auto& points : { line, triangle }) {
+        const auto mesh(Hull::generate_convex_mesh(points));
+        assert(mesh.indices.empty());
+        const Hull::Query emptyQuery(points, mesh);
+        assert(!emptyQuery.contains(vec3(100.0F, 100.0F, 100.0F)));
+        assert(!emptyQuery.contains(points[1]));
+        std::vector<unsigned char> flags(1ULL, 1);
+        emptyQuery.contains(
+            Hull::PointSpan{ points.data(), points.size() }, flags);
+        assert(
+            flags.size() == points.size() &&
+            std::count(flags.cbegin(), flags.cend(), 0) == 3);
+    }
+}
+
+void polytopeTest(const std::vector<vec3>& pointCloud) {
+    // Ensure climbing finds the farthest vertex along directions turning a
+    // little at a time, and from no start at all
+    const auto mesh(Hull::generate_convex_mesh(pointCloud));
+    const Hull::Polytope polytope(pointCloud, mesh);
+    assert(polytope.size() == mesh.vertices.size());
+    size_t count(0ULL);
+    polytope.neighbours(0ULL, count);
+    assert(count >= 3ULL);
+    size_t coherent(SIZE_MAX);
+    for (size_t step = 0ULL; step < 2000ULL; ++step) {
+        const auto angle = static_cast<float>(step) * 0.01F;
+        const vec3 direction(
+            std::cos(angle), std::sin(angle * 0.7F), std::sin(angle));
+        auto farthest = std::numeric_limits<float>::lowest();
+        for (size_t i = 0ULL; i < polytope.size(); ++i)
+            farthest = std::max(farthest, polytope.vertex(i).dot(direction));
+        size_t fresh(SIZE_MAX);
+        [[maybe_unused]] const auto fromLast =
+            polytope.support(direction, coherent);
+        [[maybe_unused]] const auto fromNothing =
+            polytope.support(direction, fresh);
+        assert(fromLast == coherent && fromNothing == fresh);
+        assert(polytope.vertex(fromLast).dot(direction) >= farthest - 1e-4F);
+        assert(
+            polytope.vertex(fromNothing).dot(direction) >= farthest - 1e-4F);
+    }
+
+    // Ensure the distances between cubes match their gaps
+    const std::vector<vec3> cube{ { -1, -1, -1 }, { 1, -1, -1 }, { -1, 1, -1 },
+                                  { 1, 1, -1 },   { -1, -1, 1 }, { 1, -1, 1 },
+                                  { -1, 1, 1 },   { 1, 1, 1 } };
+    const auto cubeMesh(Hull::generate_convex_mesh(cube));
+    const Hull::Polytope cubeA(cube, cubeMesh);
+    const auto shifted = [&](const vec3& offset) {
+        auto moved(cube);
+        for (auto& point : moved)
+            point = point + offset;
+        return Hull::Polytope(moved, cubeMesh);
+    };
+    Hull::DistanceCache cubeCache;
+    vec3 pointA;
+    vec3 pointB;
+    [[maybe_unused]] const auto apart = Hull::distance(
+        cubeA, shifted(vec3(5.0F, 0.5F, 0.0F)), cubeCache, &pointA, &pointB);
+    assert(std::abs(apart - 3.0F) < 1e-4F);
+    assert(std::abs(pointA.x() - 1.0F) < 1e-4F);
+    assert(std::abs(pointB.x() - 4.0F) < 1e-4F);
+    assert(cubeCache.vertexA < cubeA.size() && cubeCache.axis.x() < 0.0F);
+    Hull::DistanceCache edgeCache;
+    [[maybe_unused]] const auto diagonal =
+        Hull::distance(cubeA, shifted(vec3(3.0F, 3.0F, 0.0F)), edgeCache);
+    assert(std::abs(diagonal - std::sqrt(2.0F)) < 1e-4F);
+    Hull::DistanceCache overlapCache;
+    assert(Hull::intersects(
+        cubeA, shifted(vec3(1.0F, 0.0F, 0.0F)), overlapCache));
+    assert(Hull::intersects(cubeA, cubeA, overlapCache));
+
+    // Ensure the closest points of hulls drawn apart give a plane between
+    // them, reusing the cache as they move
+    Hull::CloudOptions sphere;
+    sphere.distribution = Hull::Distribution::Sphere;
+    sphere.scale = scale;
+    const auto sphereCloud(Hull::generate_point_cloud(4000ULL, seed, sphere));
+    const auto sphereMesh(Hull::generate_convex_mesh(sphereCloud));
+    const Hull::Polytope sphereA(sphereCloud, sphereMesh);
+    Hull::DistanceCache cache;
+    [[maybe_unused]] auto intersected(false);
+    for (size_t step = 0ULL; step < 64ULL; ++step) {
+        const auto gap = static_cast<float>(step) - 8.0F;
+        auto moved(sphereCloud);
+        for (auto& point : moved)
+            point = point + vec3(scale * 2.0F + gap, gap * 0.5F, 1.0F);
+        const Hull::Polytope sphereB(moved, sphereMesh);
+        const auto separation =
+            Hull::distance(sphereA, sphereB, cache, &pointA, &pointB);
+        if (separation == 0.0F) {
+            intersected = true;
+            continue;
+        }
+        assert(separation > 0.0F);
+        [[maybe_unused]] const auto normal = pointB - pointA;
+        assert(std::abs(std::sqrt(normal.dot(normal)) - separation) < 1e-3F);
+        [[maybe_unused]] const auto tolerance = 1e-3F * scale * separation;
+        for (size_t i = 0ULL; i < sphereA.size(); ++i)
+            assert((sphereA.vertex(i) - pointA).dot(normal) <= tolerance);
+        for (size_t i = 0ULL; i < sphereB.size(); ++i)
+            assert((sphereB.vertex(i) - pointB).dot(normal) >= -tolerance);
+    }
+    assert(intersected);
+
+    // Ensure empty hulls have no distance
+    const std::vector<vec3> none;
+    const Hull::Polytope empty(none, Hull::Mesh{});
+    [[maybe_unused]] size_t start(SIZE_MAX);
+    assert(empty.support(vec3(1.0F), start) == SIZE_MAX);
+    assert(Hull::distance(empty, cubeA, cache) == -1.0F);
+}